@@ -0,0 +1,91 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <bulk_schedules.h>
+#include <duration_variant.h>
+#include <quasi_coupon_schedule.h>
+
+#include <period.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	// a portfolio of 10,000 semi-annual bonds with different issue dates and tenors
+	inline auto _make_portfolio() -> vector<bond_terms>
+	{
+		auto result = vector<bond_terms>{};
+		result.reserve(10'000u);
+		for (auto i = 0; i < 10'000; ++i)
+		{
+			const auto issue = year_month_day{ sys_days{ 2000y / January / 1d } + days{ i * 7 % 3650 } };
+			const auto maturity = issue + years{ 2 + i % 29 };
+			result.emplace_back(
+				days_period{ issue, maturity },
+				SemiAnnualy,
+				maturity.month() / maturity.day()
+			);
+		}
+
+		return result;
+	}
+
+
+	static void quasi_coupon_schedules(benchmark::State& state)
+	{
+		const auto portfolio = _make_portfolio();
+		const auto threads = static_cast<unsigned>(state.range(0));
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(make_quasi_coupon_schedules(portfolio, threads));
+
+		state.SetItemsProcessed(state.iterations() * portfolio.size());
+	}
+
+	static void coupon_schedules(benchmark::State& state)
+	{
+		const auto portfolio = _make_portfolio();
+		const auto threads = static_cast<unsigned>(state.range(0));
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(make_coupon_schedules(portfolio, threads));
+
+		state.SetItemsProcessed(state.iterations() * portfolio.size());
+	}
+
+
+	// number of threads
+	BENCHMARK(quasi_coupon_schedules)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+	BENCHMARK(coupon_schedules)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+}
@@ -0,0 +1,192 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <compounding_schedule.h>
+#include <business_day_index.h>
+#include <good_day_table.h>
+#include <compounding_period.h>
+#include <coupon_period.h>
+
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+#include <cstddef>
+#include <memory_resource>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	// the original recursive implementation (kept here as a reference point)
+	inline auto _make_compounding_schedule_recursive(const coupon_period& cp, const calendar& c) -> compounding_periods
+	{
+		const auto& s = cp.get_accrual_start_date();
+		const auto& e = cp.get_accrual_end_date();
+
+		const auto effective = s;
+		const auto maturity = make_overnight_maturity(effective, c);
+		if (maturity < e)
+		{
+			auto result = _make_compounding_schedule_recursive(
+				coupon_period{ period{ maturity, e }, cp.get_pay_date(), cp.get_ex_div_date() },
+				c
+			);
+
+			result.emplace(
+				result.begin(),
+				period{ effective, maturity },
+				year_month_day{}
+			);
+
+			return result;
+		}
+		else
+		{
+			auto result = compounding_periods{};
+
+			result.emplace_back(
+				period{ s, e },
+				year_month_day{}
+			);
+
+			return result;
+		}
+	}
+
+	inline auto make_compounding_schedule_recursive(const coupon_period& cp, const calendar& c) -> compounding_periods
+	{
+		auto result = _make_compounding_schedule_recursive(cp, c);
+
+		for (auto& p : result)
+			p._reset = Preceding.adjust(p._period.get_from(), c);
+
+		return result;
+	}
+
+
+	inline auto _make_coupon_period(const benchmark::State& state) -> coupon_period
+	{
+		const auto s = 2024y / January / 2d;
+		const auto e = s + months{ state.range(0) };
+
+		return coupon_period{ period{ s, e }, e, e };
+	}
+
+
+	static void compounding_schedule_recursive(benchmark::State& state)
+	{
+		const auto cal = make_calendar_benchmark();
+		const auto cp = _make_coupon_period(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(make_compounding_schedule_recursive(cp, cal));
+	}
+
+	static void compounding_schedule(benchmark::State& state)
+	{
+		const auto cal = make_calendar_benchmark();
+		const auto cp = _make_coupon_period(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(make_compounding_schedule(cp, cal));
+	}
+
+
+	// business day adjustments from a precomputed index or table (rather than the calendar)
+	static void compounding_schedule_index(benchmark::State& state)
+	{
+		const auto index = business_day_index{ make_calendar_benchmark(), days_period{ 2000y / January / 1d, 2069y / December / 31d } };
+		const auto cp = _make_coupon_period(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(make_compounding_schedule(cp, index));
+	}
+
+	static void compounding_schedule_table(benchmark::State& state)
+	{
+		const auto table = good_day_table{ make_calendar_benchmark(), days_period{ 2000y / January / 1d, 2069y / December / 31d } };
+		const auto cp = _make_coupon_period(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(make_compounding_schedule(cp, table));
+	}
+
+
+	// a batch of 1000 schedules built and released together, from the heap or from an arena
+	static void compounding_schedule_batch(benchmark::State& state)
+	{
+		const auto cal = make_calendar_benchmark();
+		const auto cp = _make_coupon_period(state);
+
+		for (auto _ : state)
+		{
+			auto batch = vector<compounding_periods>{};
+			batch.reserve(1000u);
+			for (auto i = 0; i < 1000; ++i)
+				batch.push_back(make_compounding_schedule(cp, cal));
+
+			benchmark::DoNotOptimize(batch.data());
+		}
+	}
+
+	static void compounding_schedule_batch_pmr(benchmark::State& state)
+	{
+		const auto cal = make_calendar_benchmark();
+		const auto cp = _make_coupon_period(state);
+
+		auto buffer = vector<std::byte>(1u << 24);
+
+		for (auto _ : state)
+		{
+			auto arena = std::pmr::monotonic_buffer_resource{ buffer.data(), buffer.size() };
+
+			auto batch = std::pmr::vector<pmr::compounding_periods>{ &arena };
+			batch.reserve(1000u);
+			for (auto i = 0; i < 1000; ++i)
+				batch.push_back(make_compounding_schedule(cp, cal, &arena));
+
+			benchmark::DoNotOptimize(batch.data());
+		}
+	}
+
+
+	// length of the coupon period in months
+	BENCHMARK(compounding_schedule_recursive)->Arg(3)->Arg(12)->Arg(60)->Arg(120);
+	BENCHMARK(compounding_schedule)->Arg(3)->Arg(12)->Arg(60)->Arg(120)->Arg(360);
+	BENCHMARK(compounding_schedule_index)->Arg(3)->Arg(12)->Arg(60)->Arg(120)->Arg(360);
+	BENCHMARK(compounding_schedule_table)->Arg(3)->Arg(12)->Arg(60)->Arg(120)->Arg(360);
+	BENCHMARK(compounding_schedule_batch)->Arg(1)->Arg(3)->Arg(6);
+	BENCHMARK(compounding_schedule_batch_pmr)->Arg(1)->Arg(3)->Arg(6);
+
+}
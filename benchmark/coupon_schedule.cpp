@@ -0,0 +1,103 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <coupon_schedule.h>
+#include <coupon_period.h>
+#include <quasi_coupon_schedule.h>
+
+#include <period.h>
+#include <schedule.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	// the original implementation (kept here as a reference point)
+	inline auto _make_coupon_schedule_copy(const schedule& qcs) -> coupon_periods
+	{
+		auto result = coupon_periods{};
+
+		const auto& f = qcs.get_from_until().get_from();
+		const auto& u = qcs.get_from_until().get_until();
+
+		auto dates = qcs.get_dates();
+		dates.insert(f);
+		dates.insert(u);
+
+		auto i = dates.cbegin();
+		auto prev = *i;
+		++i;
+		while (i != dates.cend())
+		{
+			result.emplace_back(period{ prev, *i }, year_month_day{}, year_month_day{});
+			prev = *i;
+			++i;
+		}
+
+		return result;
+	}
+
+
+	inline auto _make_quasi_coupon_schedule(const benchmark::State& state) -> schedule
+	{
+		const auto issue = 2000y / January / 3d;
+
+		return make_quasi_coupon_schedule(
+			days_period{ issue, issue + years{ state.range(0) } },
+			Monthly,
+			2000y / January / 15d
+		);
+	}
+
+
+	static void coupon_schedule_copy(benchmark::State& state)
+	{
+		const auto qcs = _make_quasi_coupon_schedule(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(_make_coupon_schedule_copy(qcs));
+	}
+
+	static void coupon_schedule(benchmark::State& state)
+	{
+		const auto qcs = _make_quasi_coupon_schedule(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(_make_coupon_schedule(qcs));
+	}
+
+
+	// number of years (monthly schedule)
+	BENCHMARK(coupon_schedule_copy)->Arg(1)->Arg(10)->Arg(50);
+	BENCHMARK(coupon_schedule)->Arg(1)->Arg(10)->Arg(50);
+
+}
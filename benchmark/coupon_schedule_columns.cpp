@@ -0,0 +1,98 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <coupon_schedule_columns.h>
+#include <coupon_period.h>
+#include <day_counts.h>
+#include <day_count_variant.h>
+
+#include <period.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	// 100,000 quarterly coupons, back to back
+	inline auto _make_coupon_periods() -> coupon_periods
+	{
+		auto result = coupon_periods{};
+		result.reserve(100'000u);
+
+		auto s = 2000y / January / 15d;
+		for (auto i = 0; i < 100'000; ++i)
+		{
+			const auto e = s + months{ 3 };
+			result.emplace_back(days_period{ s, e }, e, e);
+			s = e;
+		}
+
+		return result;
+	}
+
+
+	static void fractions_rows(benchmark::State& state)
+	{
+		const auto cps = _make_coupon_periods();
+		const auto dc = day_count_variant{ actual_365_fixed{} };
+
+		auto result = vector<double>(cps.size());
+
+		for (auto _ : state)
+		{
+			for (auto i = 0u; i < cps.size(); ++i)
+				result[i] = fraction(dc, cps[i].get_accrual_start_date(), cps[i].get_accrual_end_date());
+
+			benchmark::DoNotOptimize(result.data());
+		}
+	}
+
+	static void fractions_columns(benchmark::State& state)
+	{
+		const auto columns = coupon_schedule_columns{ _make_coupon_periods() };
+		const auto dc = day_count_variant{ actual_365_fixed{} };
+
+		auto result = vector<double>(columns.size());
+
+		for (auto _ : state)
+		{
+			fractions(dc, columns.get_accrual_start_dates(), columns.get_accrual_end_dates(), result);
+
+			benchmark::DoNotOptimize(result.data());
+		}
+	}
+
+
+	BENCHMARK(fractions_rows);
+	BENCHMARK(fractions_columns);
+
+}
@@ -0,0 +1,201 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <day_counts.h>
+#include <business_day_index.h>
+#include <day_count_variant.h>
+
+#include <period.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+#include <random>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	inline auto _make_periods(const size_t n) -> vector<days_period>
+	{
+		auto gen = mt19937{ 42 };
+		auto start = uniform_int_distribution<int>{ 0, 365 * 30 };
+		auto length = uniform_int_distribution<int>{ 1, 365 * 2 };
+
+		const auto base = sys_days{ 2000y / January / 1d };
+
+		auto result = vector<days_period>{};
+		result.reserve(n);
+		for (auto i = 0u; i < n; ++i)
+		{
+			const auto s = base + days{ start(gen) };
+			const auto e = s + days{ length(gen) };
+			result.emplace_back(year_month_day{ s }, year_month_day{ e });
+		}
+
+		return result;
+	}
+
+	constexpr auto _number_of_periods = 100'000u;
+
+
+
+	static void virtual_fraction(benchmark::State& state, const day_count* dc)
+	{
+		const auto periods = _make_periods(_number_of_periods);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(dc); // so the compiler can not see which day count it is
+
+			auto sum = 0.0;
+			for (const auto& p : periods)
+				sum += dc->fraction(p);
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * periods.size());
+	}
+
+	static void virtual_fractions(benchmark::State& state, const day_count* dc)
+	{
+		const auto periods = _make_periods(_number_of_periods);
+		auto result = vector<double>(periods.size());
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(dc);
+
+			dc->fractions(periods, result);
+
+			benchmark::DoNotOptimize(result.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * periods.size());
+	}
+
+	static void variant_fraction(benchmark::State& state, const day_count_variant& dcv)
+	{
+		const auto periods = _make_periods(_number_of_periods);
+
+		for (auto _ : state)
+		{
+			auto sum = 0.0;
+			for (const auto& p : periods)
+				sum += fraction(dcv, p);
+
+			benchmark::DoNotOptimize(sum);
+		}
+
+		state.SetItemsProcessed(state.iterations() * periods.size());
+	}
+
+	static void variant_fractions(benchmark::State& state, const day_count_variant& dcv)
+	{
+		const auto periods = _make_periods(_number_of_periods);
+		auto result = vector<double>(periods.size());
+
+		for (auto _ : state)
+		{
+			fractions(dcv, periods, result);
+
+			benchmark::DoNotOptimize(result.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * periods.size());
+	}
+
+
+	// business days counted by the calendar or by a precomputed index
+	static void calculation_252_calendar(benchmark::State& state)
+	{
+		const auto cal = make_calendar_benchmark();
+		const auto periods = _make_periods(state.range(0));
+		auto result = vector<double>(periods.size());
+
+		const auto dc = calculation_252{ &cal };
+
+		for (auto _ : state)
+		{
+			fractions(dc, periods, result);
+
+			benchmark::DoNotOptimize(result.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * periods.size());
+	}
+
+	static void calculation_252_index(benchmark::State& state)
+	{
+		const auto cal = make_calendar_benchmark();
+		const auto index = business_day_index{ cal, days_period{ 2000y / January / 1d, 2069y / December / 31d } };
+		const auto periods = _make_periods(state.range(0));
+		auto result = vector<double>(periods.size());
+
+		const auto dc = calculation_252{ &index };
+
+		for (auto _ : state)
+		{
+			fractions(dc, periods, result);
+
+			benchmark::DoNotOptimize(result.data());
+		}
+
+		state.SetItemsProcessed(state.iterations() * periods.size());
+	}
+
+
+	BENCHMARK_CAPTURE(virtual_fraction, actual_360, &Actual360);
+	BENCHMARK_CAPTURE(virtual_fractions, actual_360, &Actual360);
+	BENCHMARK_CAPTURE(variant_fraction, actual_360, day_count_variant{ Actual360 });
+	BENCHMARK_CAPTURE(variant_fractions, actual_360, day_count_variant{ Actual360 });
+
+	BENCHMARK_CAPTURE(virtual_fraction, actual_actual, &ActualActual);
+	BENCHMARK_CAPTURE(virtual_fractions, actual_actual, &ActualActual);
+	BENCHMARK_CAPTURE(variant_fraction, actual_actual, day_count_variant{ ActualActual });
+	BENCHMARK_CAPTURE(variant_fractions, actual_actual, day_count_variant{ ActualActual });
+
+	BENCHMARK_CAPTURE(virtual_fraction, thirty_360, &Thirty360);
+	BENCHMARK_CAPTURE(virtual_fractions, thirty_360, &Thirty360);
+	BENCHMARK_CAPTURE(variant_fraction, thirty_360, day_count_variant{ Thirty360 });
+	BENCHMARK_CAPTURE(variant_fractions, thirty_360, day_count_variant{ Thirty360 });
+
+	const auto ThirtyE360ISDA = thirty_e_360_isda{ 2032y / February / 29d };
+
+	BENCHMARK_CAPTURE(virtual_fraction, thirty_e_360_isda, &ThirtyE360ISDA);
+	BENCHMARK_CAPTURE(virtual_fractions, thirty_e_360_isda, &ThirtyE360ISDA);
+
+
+	BENCHMARK(calculation_252_calendar)->Arg(1'000);
+	BENCHMARK(calculation_252_index)->Arg(1'000)->Arg(100'000);
+
+}
@@ -0,0 +1,115 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <flat_schedule.h>
+#include <fixed_frequency.h>
+#include <quasi_coupon_schedule.h>
+
+#include <period.h>
+#include <schedule.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+#include <optional>
+#include <iterator>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	inline auto _make_issue_maturity(const benchmark::State& state) -> days_period
+	{
+		const auto issue = 2000y / January / 3d;
+
+		return days_period{ issue, issue + years{ state.range(0) } };
+	}
+
+
+	static void quasi_coupon_schedule_set(benchmark::State& state)
+	{
+		const auto i_m = _make_issue_maturity(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(make_quasi_coupon_schedule(i_m, Monthly, 2000y / January / 15d));
+	}
+
+	static void quasi_coupon_schedule_flat(benchmark::State& state)
+	{
+		const auto i_m = _make_issue_maturity(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(make_flat_quasi_coupon_schedule(i_m, Monthly, 2000y / January / 15d));
+	}
+
+
+	static void quasi_coupon_schedule_fixed(benchmark::State& state)
+	{
+		const auto i_m = _make_issue_maturity(state);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(make_quasi_coupon_schedule(i_m, monthly{}, 2000y / January / 15d));
+	}
+
+
+	// every day in the schedule is looked up once
+	static void lookup_set(benchmark::State& state)
+	{
+		const auto i_m = _make_issue_maturity(state);
+		const auto s = make_quasi_coupon_schedule(i_m, Monthly, 2000y / January / 15d);
+		const auto& ds = s.get_dates();
+
+		for (auto _ : state)
+			for (auto d = sys_days{ i_m.get_from() }; d <= sys_days{ i_m.get_until() }; d += days{ 1 })
+			{
+				// same as flat_schedule::find_not_after
+				const auto i = ds.upper_bound(d);
+				benchmark::DoNotOptimize(i == ds.cbegin() ? optional<year_month_day>{} : *std::prev(i));
+			}
+	}
+
+	static void lookup_flat(benchmark::State& state)
+	{
+		const auto i_m = _make_issue_maturity(state);
+		const auto s = make_flat_quasi_coupon_schedule(i_m, Monthly, 2000y / January / 15d);
+
+		for (auto _ : state)
+			for (auto d = sys_days{ i_m.get_from() }; d <= sys_days{ i_m.get_until() }; d += days{ 1 })
+				benchmark::DoNotOptimize(s.find_not_after(d));
+	}
+
+
+	// number of years (monthly schedule)
+	BENCHMARK(quasi_coupon_schedule_set)->Arg(1)->Arg(10)->Arg(50);
+	BENCHMARK(quasi_coupon_schedule_flat)->Arg(1)->Arg(10)->Arg(50);
+	BENCHMARK(quasi_coupon_schedule_fixed)->Arg(1)->Arg(10)->Arg(50);
+	BENCHMARK(lookup_set)->Arg(1)->Arg(10)->Arg(50);
+	BENCHMARK(lookup_flat)->Arg(1)->Arg(10)->Arg(50);
+
+}
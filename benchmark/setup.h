@@ -0,0 +1,60 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <annual_holidays.h>
+#include <weekend.h>
+#include <schedule.h>
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <chrono>
+
+
+namespace coupon_schedule
+{
+
+	// simplified England-like calendar, which is long enough for 30 year FRNs
+	inline auto make_calendar_benchmark() -> gregorian::calendar
+	{
+		using namespace std::chrono;
+
+		auto rules = gregorian::annual_holiday_storage{
+			&gregorian::NewYearsDay,
+			&gregorian::GoodFriday,
+			&gregorian::EasterMonday,
+			&gregorian::ChristmasDay,
+			&gregorian::BoxingDay
+		};
+
+		auto cal = gregorian::calendar{
+			gregorian::SaturdaySundayWeekend,
+			gregorian::make_holiday_schedule(gregorian::years_period{ 2000y, 2070y }, rules)
+		};
+		cal.substitute(gregorian::Following);
+
+		return cal;
+	}
+
+}
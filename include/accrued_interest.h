@@ -0,0 +1,168 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "coupon_period.h"
+#include "day_count_variant.h"
+
+#include <chrono>
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include <cstddef>
+
+
+namespace coupon_schedule
+{
+
+	// the coupon period with start <= settlement < end (coupon periods are expected to be sorted and back to back)
+	inline auto find_coupon_period(
+		const coupon_periods& cps,
+		const std::chrono::year_month_day& settlement
+	) -> const coupon_period&
+	{
+		const auto i = std::ranges::upper_bound(cps, settlement, {}, &coupon_period::get_accrual_end_date);
+		if (i == cps.cend() || settlement < i->get_accrual_start_date())
+			throw std::out_of_range{ "Settlement date is outside of the coupon schedule" };
+
+		return *i;
+	}
+
+
+	// as a fraction of a year (to be multiplied by the coupon rate)
+	// on or after the ex-div date the buyer does not get the next coupon, so accrued is negative (as in [1])
+	inline auto accrued_fraction(
+		const coupon_period& cp,
+		const std::chrono::year_month_day& settlement,
+		const day_count_variant& dc
+	) -> double
+	{
+		if (settlement < cp.get_ex_div_date())
+			return fraction(dc, cp.get_accrual_start_date(), settlement);
+		else
+			return -fraction(dc, settlement, cp.get_accrual_end_date());
+	}
+
+
+	inline auto accrued_fraction(
+		const coupon_periods& cps,
+		const std::chrono::year_month_day& settlement,
+		const day_count_variant& dc
+	) -> double
+	{
+		return accrued_fraction(find_coupon_period(cps, settlement), settlement, dc);
+	}
+
+
+
+	// everything about a bond needed for accrued interest
+	class accrual_schedule
+	{
+
+	public:
+
+		accrual_schedule(
+			coupon_periods cps,
+			day_count_variant dc
+		);
+
+	public:
+
+		auto get_coupon_periods() const noexcept -> const coupon_periods&;
+		auto get_day_count() const noexcept -> const day_count_variant&;
+
+		auto accrued_fraction(const std::chrono::year_month_day& settlement) const -> double;
+
+	private:
+
+		coupon_periods _cps;
+		day_count_variant _dc;
+
+	};
+
+
+
+	inline accrual_schedule::accrual_schedule(
+		coupon_periods cps,
+		day_count_variant dc
+	) :
+		_cps{ std::move(cps) },
+		_dc{ std::move(dc) }
+	{
+		if (_cps.empty())
+			throw std::out_of_range{ "Accrual schedule should have at least one coupon period" };
+	}
+
+
+	inline auto accrual_schedule::get_coupon_periods() const noexcept -> const coupon_periods&
+	{
+		return _cps;
+	}
+
+
+	inline auto accrual_schedule::get_day_count() const noexcept -> const day_count_variant&
+	{
+		return _dc;
+	}
+
+
+	inline auto accrual_schedule::accrued_fraction(const std::chrono::year_month_day& settlement) const -> double
+	{
+		return coupon_schedule::accrued_fraction(_cps, settlement, _dc);
+	}
+
+
+
+	// one result per (bond, settlement date) pair
+	inline auto accrued_fractions(
+		std::span<const accrual_schedule* const> bonds,
+		std::span<const std::chrono::year_month_day> settlements,
+		std::span<double> result
+	) -> void
+	{
+		if (bonds.size() != settlements.size() || bonds.size() != result.size())
+			throw std::out_of_range{ "Number of bonds, settlement dates and results should be the same" };
+
+		for (auto i = std::size_t{ 0 }; i < bonds.size(); ++i)
+			result[i] = bonds[i]->accrued_fraction(settlements[i]);
+	}
+
+
+	// many settlement dates for the same bond (e.g. all the fills of an order)
+	inline auto accrued_fractions(
+		const accrual_schedule& bond,
+		std::span<const std::chrono::year_month_day> settlements,
+		std::span<double> result
+	) -> void
+	{
+		if (settlements.size() != result.size())
+			throw std::out_of_range{ "Number of settlement dates and results should be the same" };
+
+		for (auto i = std::size_t{ 0 }; i < settlements.size(); ++i)
+			result[i] = bond.accrued_fraction(settlements[i]);
+	}
+
+}
@@ -0,0 +1,210 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "duration_variant.h"
+#include "compact_frequency.h"
+#include "quasi_coupon_schedule.h"
+#include "coupon_period.h"
+#include "coupon_schedule.h"
+
+#include <period.h>
+#include <schedule.h>
+
+#include <chrono>
+#include <vector>
+#include <span>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+
+namespace coupon_schedule
+{
+
+	// what we need to know about a bond to build its schedules
+	class bond_terms
+	{
+
+	public:
+
+		bond_terms(
+			gregorian::days_period issue_maturity,
+			compact_frequency frequency,
+			quasi_coupon_anchor anchor
+		) noexcept;
+		bond_terms(
+			gregorian::days_period issue_maturity,
+			const duration_variant& frequency,
+			quasi_coupon_anchor anchor
+		);
+
+	public:
+
+		friend auto operator==(const bond_terms& t1, const bond_terms& t2) noexcept -> bool = default;
+
+	public:
+
+		auto get_issue_maturity() const noexcept -> const gregorian::days_period&;
+		auto get_frequency() const -> duration_variant; // in the units it was given in
+		auto get_anchor() const noexcept -> const quasi_coupon_anchor&;
+
+	private:
+
+		gregorian::days_period _issue_maturity;
+		compact_frequency _frequency; // a lot of these are kept around, so we do not store the full variant
+		quasi_coupon_anchor _anchor;
+
+	};
+
+
+
+	inline bond_terms::bond_terms(
+		gregorian::days_period issue_maturity,
+		compact_frequency frequency,
+		quasi_coupon_anchor anchor
+	) noexcept :
+		_issue_maturity{ std::move(issue_maturity) },
+		_frequency{ frequency },
+		_anchor{ std::move(anchor) }
+	{
+	}
+
+
+	inline bond_terms::bond_terms(
+		gregorian::days_period issue_maturity,
+		const duration_variant& frequency,
+		quasi_coupon_anchor anchor
+	) :
+		bond_terms{ std::move(issue_maturity), compact_frequency{ frequency }, std::move(anchor) }
+	{
+	}
+
+
+	inline auto bond_terms::get_issue_maturity() const noexcept -> const gregorian::days_period&
+	{
+		return _issue_maturity;
+	}
+
+
+	inline auto bond_terms::get_frequency() const -> duration_variant
+	{
+		return _frequency.to_duration_variant();
+	}
+
+
+	inline auto bond_terms::get_anchor() const noexcept -> const quasi_coupon_anchor&
+	{
+		return _anchor;
+	}
+
+
+
+	inline auto _default_number_of_threads() noexcept -> unsigned
+	{
+		return std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+
+	// each thread gets a contiguous chunk and its own output, which are joined in order at the end
+	// (so the result does not depend on the number of threads)
+	template<typename T, typename F>
+	auto _make_in_parallel(std::span<const bond_terms> terms, unsigned threads, const F& make) -> std::vector<T>
+	{
+		if (threads == 0u)
+			threads = _default_number_of_threads();
+
+		const auto n = terms.size();
+		const auto chunks = std::max<std::size_t>(std::min<std::size_t>(threads, n), 1u);
+		const auto chunk_size = (n + chunks - 1u) / chunks;
+
+		auto outputs = std::vector<std::vector<T>>(chunks);
+		auto errors = std::vector<std::exception_ptr>(chunks);
+
+		const auto work = [&](const std::size_t c) {
+			try
+			{
+				const auto b = std::min(c * chunk_size, n);
+				const auto e = std::min(b + chunk_size, n);
+
+				auto& output = outputs[c];
+				output.reserve(e - b);
+				for (auto i = b; i < e; ++i)
+					output.push_back(make(terms[i]));
+			}
+			catch (...)
+			{
+				errors[c] = std::current_exception();
+			}
+		};
+
+		{
+			auto workers = std::vector<std::jthread>{};
+			workers.reserve(chunks - 1u);
+			for (auto c = std::size_t{ 1 }; c < chunks; ++c)
+				workers.emplace_back(work, c);
+
+			work(0u); // the calling thread does its share too
+		}
+
+		for (const auto& e : errors)
+			if (e)
+				std::rethrow_exception(e);
+
+		if (chunks == 1u)
+			return std::move(outputs.front());
+
+		auto result = std::vector<T>{};
+		result.reserve(n);
+		for (auto& output : outputs)
+			std::move(output.begin(), output.end(), std::back_inserter(result));
+
+		return result;
+	}
+
+
+	inline auto make_quasi_coupon_schedules(
+		std::span<const bond_terms> terms,
+		const unsigned threads = _default_number_of_threads()
+	) -> std::vector<gregorian::schedule>
+	{
+		return _make_in_parallel<gregorian::schedule>(terms, threads, [](const bond_terms& t) {
+			return make_quasi_coupon_schedule(t.get_issue_maturity(), t.get_frequency(), t.get_anchor());
+		});
+	}
+
+
+	inline auto make_coupon_schedules(
+		std::span<const bond_terms> terms,
+		const unsigned threads = _default_number_of_threads()
+	) -> std::vector<coupon_periods>
+	{
+		return _make_in_parallel<coupon_periods>(terms, threads, [](const bond_terms& t) {
+			return _make_coupon_schedule(make_quasi_coupon_schedule(t.get_issue_maturity(), t.get_frequency(), t.get_anchor()));
+		});
+	}
+
+}
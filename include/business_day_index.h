@@ -0,0 +1,227 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <period.h>
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <chrono>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <concepts>
+#include <stdexcept>
+
+
+namespace coupon_schedule
+{
+
+	// business days of a calendar over a range of dates, precomputed as a bitmap (one bit per day)
+	// with the number of business days before each 64 day block
+	class business_day_index
+	{
+
+	public:
+
+		business_day_index(
+			const gregorian::calendar& cal,
+			gregorian::days_period from_until
+		);
+
+	public:
+
+		auto get_from_until() const noexcept -> const gregorian::days_period&;
+
+		auto is_business_day(const std::chrono::year_month_day& d) const -> bool;
+
+		// same as gregorian::calendar::count_business_days (both ends are included)
+		auto count_business_days(const gregorian::days_period& p) const -> std::size_t;
+
+		// same as gregorian::Following and gregorian::Preceding adjustments
+		auto following(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day;
+		auto preceding(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day;
+
+	private:
+
+		auto _offset(const std::chrono::year_month_day& d) const -> std::size_t;
+
+		// number of business days in [from, from + i)
+		auto _count_before(const std::size_t i) const noexcept -> std::size_t;
+
+	private:
+
+		using _word = std::uint64_t;
+		static constexpr auto _word_bits = std::size_t{ 64 };
+
+	private:
+
+		gregorian::days_period _from_until;
+		std::chrono::sys_days _from;
+		std::size_t _size;
+
+		std::vector<_word> _bits;
+		std::vector<std::uint32_t> _counts;
+
+	};
+
+
+
+	inline business_day_index::business_day_index(
+		const gregorian::calendar& cal,
+		gregorian::days_period from_until
+	) :
+		_from_until{ std::move(from_until) },
+		_from{ _from_until.get_from() },
+		_size{ static_cast<std::size_t>((std::chrono::sys_days{ _from_until.get_until() } - _from).count()) + 1u }
+	{
+		const auto words = (_size + _word_bits - 1u) / _word_bits;
+
+		_bits.resize(words);
+		for (auto i = std::size_t{ 0 }; i < _size; ++i)
+			if (cal.is_business_day(_from + std::chrono::days{ i }))
+				_bits[i / _word_bits] |= _word{ 1 } << (i % _word_bits);
+
+		_counts.reserve(words + 1u);
+		_counts.push_back(0u);
+		for (const auto w : _bits)
+			_counts.push_back(_counts.back() + static_cast<std::uint32_t>(std::popcount(w)));
+	}
+
+
+	inline auto business_day_index::get_from_until() const noexcept -> const gregorian::days_period&
+	{
+		return _from_until;
+	}
+
+
+	inline auto business_day_index::_offset(const std::chrono::year_month_day& d) const -> std::size_t
+	{
+		const auto i = (std::chrono::sys_days{ d } - _from).count();
+		if (i < 0 || static_cast<std::size_t>(i) >= _size)
+			throw std::out_of_range{ "Date is outside of the business day index" };
+
+		return static_cast<std::size_t>(i);
+	}
+
+
+	inline auto business_day_index::_count_before(const std::size_t i) const noexcept -> std::size_t
+	{
+		const auto w = i / _word_bits;
+		const auto b = i % _word_bits;
+
+		if (b == 0u)
+			return _counts[w];
+		else
+			return _counts[w] + static_cast<std::size_t>(std::popcount(_bits[w] & ((_word{ 1 } << b) - 1u)));
+	}
+
+
+	inline auto business_day_index::is_business_day(const std::chrono::year_month_day& d) const -> bool
+	{
+		const auto i = _offset(d);
+
+		return (_bits[i / _word_bits] >> (i % _word_bits)) & 1u;
+	}
+
+
+	inline auto business_day_index::count_business_days(const gregorian::days_period& p) const -> std::size_t
+	{
+		const auto f = _offset(p.get_from());
+		const auto u = _offset(p.get_until());
+
+		return _count_before(u + 1u) - _count_before(f);
+	}
+
+
+	inline auto business_day_index::following(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day
+	{
+		const auto i = _offset(d);
+
+		auto w = i / _word_bits;
+		auto bits = _bits[w] & (~_word{ 0 } << (i % _word_bits)); // ignore the days before d
+		while (bits == 0u)
+		{
+			if (++w == _bits.size())
+				throw std::out_of_range{ "No business day in the index on or after the date" };
+
+			bits = _bits[w];
+		}
+
+		return _from + std::chrono::days{ w * _word_bits + static_cast<std::size_t>(std::countr_zero(bits)) };
+	}
+
+
+	inline auto business_day_index::preceding(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day
+	{
+		const auto i = _offset(d);
+
+		auto w = i / _word_bits;
+		auto bits = _bits[w] & (~_word{ 0 } >> (_word_bits - 1u - i % _word_bits)); // ignore the days after d
+		while (bits == 0u)
+		{
+			if (w-- == 0u)
+				throw std::out_of_range{ "No business day in the index on or before the date" };
+
+			bits = _bits[w];
+		}
+
+		return _from + std::chrono::days{ w * _word_bits + _word_bits - 1u - static_cast<std::size_t>(std::countl_zero(bits)) };
+	}
+
+
+
+	// so the same code can adjust with either a calendar or an index
+
+	inline auto _following(const std::chrono::year_month_day& d, const gregorian::calendar& cal) -> std::chrono::year_month_day
+	{
+		return gregorian::Following.adjust(d, cal);
+	}
+
+	inline auto _following(const std::chrono::year_month_day& d, const business_day_index& index) -> std::chrono::year_month_day
+	{
+		return index.following(d);
+	}
+
+	inline auto _preceding(const std::chrono::year_month_day& d, const gregorian::calendar& cal) -> std::chrono::year_month_day
+	{
+		return gregorian::Preceding.adjust(d, cal);
+	}
+
+	inline auto _preceding(const std::chrono::year_month_day& d, const business_day_index& index) -> std::chrono::year_month_day
+	{
+		return index.preceding(d);
+	}
+
+
+	// a calendar, a business_day_index or a good_day_table
+	template<typename T>
+	concept business_day_lookup = requires(const std::chrono::year_month_day& d, const T& c)
+	{
+		{ _following(d, c) } -> std::convertible_to<std::chrono::year_month_day>;
+		{ _preceding(d, c) } -> std::convertible_to<std::chrono::year_month_day>;
+	};
+
+}
@@ -0,0 +1,128 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+
+namespace coupon_schedule
+{
+
+	// days since 1970-01-01 (the same as sys_days, but only 32 bits, so more of them fit into a vector register)
+	using day_serial = std::int32_t;
+
+	// batches are worked on a block of dates at a time (small enough for the columns to stay on the stack and in cache)
+	constexpr auto _dates_block_size = std::size_t{ 256 };
+
+
+
+	// C. Neri and L. Schneider, "Euclidean affine functions and their application to calendar algorithms" (2022):
+	// the same results as H. Hinnant's algorithms, but with divisions by constants that become multiplications
+	// (and no branches, so that loops over them can be vectorised)
+
+	constexpr auto _calendar_shift = static_cast<std::uint32_t>(-1468000); // years, so that all dates we care about are positive
+	constexpr auto _days_shift = static_cast<std::uint32_t>(536895458); // the same shift in days (plus the 1970 epoch)
+
+	constexpr auto _days_from_civil(const int y, const unsigned m, const unsigned d) noexcept -> day_serial
+	{
+		// the year starts on 1st March, so the leap day is at the end of it
+		const auto j = static_cast<std::uint32_t>(m < 3u);
+		const auto y0 = static_cast<std::uint32_t>(y) - _calendar_shift - j;
+		const auto m0 = m + 12u * j;
+		const auto c = y0 / 100u;
+
+		const auto yc = 1461u * y0 / 4u - c + c / 4u;
+		const auto mc = (979u * m0 - 2919u) / 32u;
+
+		return static_cast<day_serial>(yc + mc + d - 1u - _days_shift);
+	}
+
+	constexpr auto _civil_from_days(const day_serial serial) noexcept -> std::chrono::year_month_day
+	{
+		const auto n1 = 4u * (static_cast<std::uint32_t>(serial) + _days_shift) + 3u;
+		const auto q1 = n1 / 146097u; // centuries
+		const auto r1 = n1 % 146097u / 4u;
+
+		const auto n2 = 4u * r1 + 3u;
+		const auto u2 = std::uint64_t{ 2939745u } * n2;
+		const auto q2 = static_cast<std::uint32_t>(u2 >> 32); // years in the century
+		const auto r2 = static_cast<std::uint32_t>(u2) / 2939745u / 4u; // day of the year (starting from 1st March)
+
+		const auto n3 = 2141u * r2 + 197913u;
+		const auto m0 = n3 >> 16;
+		const auto d0 = (n3 & 0xFFFFu) / 2141u;
+
+		const auto j = static_cast<std::uint32_t>(r2 >= 306u); // January or February
+		const auto y = static_cast<int>(100u * q1 + q2 + j + _calendar_shift);
+
+		return std::chrono::year{ y } / std::chrono::month{ m0 - 12u * j } / std::chrono::day{ d0 + 1u };
+	}
+
+
+	constexpr auto to_day_serial(const std::chrono::year_month_day& ymd) noexcept -> day_serial
+	{
+		return _days_from_civil(
+			static_cast<int>(ymd.year()),
+			static_cast<unsigned>(ymd.month()),
+			static_cast<unsigned>(ymd.day())
+		);
+	}
+
+	constexpr auto from_day_serial(const day_serial serial) noexcept -> std::chrono::year_month_day
+	{
+		return _civil_from_days(serial);
+	}
+
+
+
+	// batch conversions (plain loops over the kernels above, which the compiler can vectorise)
+	inline auto to_day_serials(
+		std::span<const std::chrono::year_month_day> dates,
+		std::span<day_serial> result
+	) -> void
+	{
+		if (dates.size() != result.size())
+			throw std::out_of_range{ "Number of dates and serials should be the same" };
+
+		for (auto i = std::size_t{ 0 }; i < dates.size(); ++i)
+			result[i] = to_day_serial(dates[i]);
+	}
+
+	inline auto from_day_serials(
+		std::span<const day_serial> serials,
+		std::span<std::chrono::year_month_day> result
+	) -> void
+	{
+		if (serials.size() != result.size())
+			throw std::out_of_range{ "Number of serials and dates should be the same" };
+
+		for (auto i = std::size_t{ 0 }; i < serials.size(); ++i)
+			result[i] = from_day_serial(serials[i]);
+	}
+
+}
@@ -0,0 +1,204 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "coupon_period.h"
+
+#include <period.h>
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+
+namespace coupon_schedule
+{
+
+	// the same information as coupon_period, but as days since the epoch (so 16 bytes per coupon)
+	class compact_coupon_period
+	{
+
+	public:
+
+		using serial = std::int32_t;
+
+	public:
+
+		compact_coupon_period() noexcept = delete;
+		compact_coupon_period(const compact_coupon_period&) noexcept = default;
+		compact_coupon_period(compact_coupon_period&&) noexcept = default;
+
+		compact_coupon_period(
+			std::chrono::sys_days accrual_start,
+			std::chrono::sys_days accrual_end,
+			std::chrono::sys_days pay,
+			std::chrono::sys_days ex_div
+		) noexcept;
+
+		explicit compact_coupon_period(const coupon_period& cp); // throws if the year or month of any of the dates is not valid
+
+		~compact_coupon_period() noexcept = default;
+
+		compact_coupon_period& operator=(const compact_coupon_period&) noexcept = default;
+		compact_coupon_period& operator=(compact_coupon_period&&) noexcept = default;
+
+	public:
+
+		friend auto operator==(const compact_coupon_period& p1, const compact_coupon_period& p2) noexcept -> bool = default;
+
+	public:
+
+		auto get_accrual_start_date() const noexcept -> std::chrono::sys_days;
+		auto get_accrual_end_date() const noexcept -> std::chrono::sys_days;
+		auto get_pay_date() const noexcept -> std::chrono::sys_days;
+		auto get_ex_div_date() const noexcept -> std::chrono::sys_days;
+
+		auto to_coupon_period() const -> coupon_period;
+
+	private:
+
+		serial _accrual_start;
+		serial _accrual_end;
+		serial _pay;
+		serial _ex_div;
+
+	};
+
+
+	static_assert(sizeof(compact_coupon_period) == 4 * sizeof(compact_coupon_period::serial));
+
+
+
+	using compact_coupon_periods = std::vector<compact_coupon_period>;
+
+
+
+	inline auto _to_serial(const std::chrono::sys_days d) noexcept -> compact_coupon_period::serial
+	{
+		return static_cast<compact_coupon_period::serial>(d.time_since_epoch().count());
+	}
+
+	inline auto _from_serial(const compact_coupon_period::serial s) noexcept -> std::chrono::sys_days
+	{
+		return std::chrono::sys_days{ std::chrono::days{ s } };
+	}
+
+
+
+	inline compact_coupon_period::compact_coupon_period(
+		std::chrono::sys_days accrual_start,
+		std::chrono::sys_days accrual_end,
+		std::chrono::sys_days pay,
+		std::chrono::sys_days ex_div
+	) noexcept :
+		_accrual_start{ _to_serial(accrual_start) },
+		_accrual_end{ _to_serial(accrual_end) },
+		_pay{ _to_serial(pay) },
+		_ex_div{ _to_serial(ex_div) }
+	{
+	}
+
+
+	// days past the end of the month roll over into the next one (e.g. February 31 is March 3), as std::chrono defines it
+	// (only a bad year or month makes sys_days unspecified)
+	inline auto _to_sys_days(const std::chrono::year_month_day& d) -> std::chrono::sys_days
+	{
+		if (!d.year().ok() || !d.month().ok())
+			throw std::out_of_range{ "Dates of a compact coupon period should have a valid year and month" };
+
+		return std::chrono::sys_days{ d };
+	}
+
+
+	inline compact_coupon_period::compact_coupon_period(const coupon_period& cp) :
+		compact_coupon_period{
+			_to_sys_days(cp.get_accrual_start_date()),
+			_to_sys_days(cp.get_accrual_end_date()),
+			_to_sys_days(cp.get_pay_date()),
+			_to_sys_days(cp.get_ex_div_date())
+		}
+	{
+	}
+
+
+
+	inline auto compact_coupon_period::get_accrual_start_date() const noexcept -> std::chrono::sys_days
+	{
+		return _from_serial(_accrual_start);
+	}
+
+
+	inline auto compact_coupon_period::get_accrual_end_date() const noexcept -> std::chrono::sys_days
+	{
+		return _from_serial(_accrual_end);
+	}
+
+
+	inline auto compact_coupon_period::get_pay_date() const noexcept -> std::chrono::sys_days
+	{
+		return _from_serial(_pay);
+	}
+
+
+	inline auto compact_coupon_period::get_ex_div_date() const noexcept -> std::chrono::sys_days
+	{
+		return _from_serial(_ex_div);
+	}
+
+
+	inline auto compact_coupon_period::to_coupon_period() const -> coupon_period
+	{
+		return coupon_period{
+			gregorian::days_period{ get_accrual_start_date(), get_accrual_end_date() },
+			get_pay_date(),
+			get_ex_div_date()
+		};
+	}
+
+
+
+	inline auto make_compact_coupon_periods(const coupon_periods& cps) -> compact_coupon_periods
+	{
+		auto result = compact_coupon_periods{};
+		result.reserve(cps.size());
+
+		for (const auto& cp : cps)
+			result.emplace_back(cp);
+
+		return result;
+	}
+
+	inline auto make_coupon_periods(const compact_coupon_periods& cps) -> coupon_periods
+	{
+		auto result = coupon_periods{};
+		result.reserve(cps.size());
+
+		for (const auto& cp : cps)
+			result.push_back(cp.to_coupon_period());
+
+		return result;
+	}
+
+}
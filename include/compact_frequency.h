@@ -0,0 +1,205 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "duration_variant.h"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+
+namespace coupon_schedule
+{
+
+	// weeks are just 7 days and years are just 12 months, as far as schedules are concerned
+	// (but compact_frequency remembers them, so that the original duration_variant can be restored)
+	enum class frequency_unit : std::uint8_t
+	{
+		days,
+		months,
+	};
+
+
+	// the same frequency as duration_variant, but as days or months and small enough to be passed around in a register
+	// (so the innermost schedule loops do not need to visit a variant)
+	class compact_frequency
+	{
+
+	public:
+
+		constexpr compact_frequency() noexcept = default;
+
+		// weeks_or_years means that count (of days or months) was given in weeks or years
+		constexpr compact_frequency(frequency_unit unit, std::int32_t count, bool weeks_or_years = false) noexcept;
+
+		// explicit, as it throws if the count does not fit
+		constexpr explicit compact_frequency(const duration_variant& frequency);
+
+	public:
+
+		friend constexpr auto operator==(const compact_frequency& f1, const compact_frequency& f2) noexcept -> bool = default;
+
+	public:
+
+		constexpr auto get_unit() const noexcept -> frequency_unit;
+		constexpr auto get_count() const noexcept -> std::int32_t;
+		constexpr auto is_weeks_or_years() const noexcept -> bool;
+
+		constexpr auto to_duration_variant() const -> duration_variant;
+
+	private:
+
+		static constexpr auto _make_count(long long count) -> std::int32_t;
+
+	private:
+
+		std::int32_t _count = 0;
+		frequency_unit _unit = frequency_unit::days;
+		bool _weeks_or_years = false; // in the spare bytes
+
+	};
+
+
+	static_assert(sizeof(compact_frequency) <= 8u);
+	static_assert(std::is_trivially_copyable_v<compact_frequency>);
+
+
+
+	constexpr compact_frequency::compact_frequency(frequency_unit unit, std::int32_t count, bool weeks_or_years) noexcept :
+		_count{ count },
+		_unit{ unit },
+		_weeks_or_years{ weeks_or_years }
+	{
+	}
+
+
+	constexpr compact_frequency::compact_frequency(const duration_variant& frequency)
+	{
+		std::visit(
+			overloaded{
+				[this](const std::chrono::days& ds) { _unit = frequency_unit::days; _count = _make_count(ds.count()); },
+				[this](const std::chrono::weeks& ws) { _unit = frequency_unit::days; _count = _make_count(ws.count() * 7); _weeks_or_years = true; },
+				[this](const std::chrono::months& ms) { _unit = frequency_unit::months; _count = _make_count(ms.count()); },
+				[this](const std::chrono::years& ys) { _unit = frequency_unit::months; _count = _make_count(ys.count() * 12); _weeks_or_years = true; },
+			},
+			frequency
+		);
+	}
+
+
+	constexpr auto compact_frequency::get_unit() const noexcept -> frequency_unit
+	{
+		return _unit;
+	}
+
+
+	constexpr auto compact_frequency::get_count() const noexcept -> std::int32_t
+	{
+		return _count;
+	}
+
+
+	constexpr auto compact_frequency::is_weeks_or_years() const noexcept -> bool
+	{
+		return _weeks_or_years;
+	}
+
+
+	constexpr auto compact_frequency::to_duration_variant() const -> duration_variant
+	{
+		if (_unit == frequency_unit::days)
+		{
+			if (_weeks_or_years && _count % 7 == 0)
+				return duration_variant{ std::chrono::weeks{ _count / 7 } };
+			else
+				return duration_variant{ std::chrono::days{ _count } };
+		}
+		else
+		{
+			if (_weeks_or_years && _count % 12 == 0)
+				return duration_variant{ std::chrono::years{ _count / 12 } };
+			else
+				return duration_variant{ std::chrono::months{ _count } };
+		}
+	}
+
+
+	constexpr auto compact_frequency::_make_count(long long count) -> std::int32_t
+	{
+		if (count < std::numeric_limits<std::int32_t>::min() || count > std::numeric_limits<std::int32_t>::max())
+			throw std::out_of_range{ "Frequency is too long" };
+
+		return static_cast<std::int32_t>(count);
+	}
+
+
+
+	// call f with the frequency as a single chrono duration (days or months)
+	template<typename F>
+	constexpr auto _visit(F&& f, const compact_frequency& frequency) -> decltype(auto)
+	{
+		if (frequency.get_unit() == frequency_unit::days)
+			return std::forward<F>(f)(std::chrono::days{ frequency.get_count() });
+		else
+			return std::forward<F>(f)(std::chrono::months{ frequency.get_count() });
+	}
+
+
+	constexpr auto _advance_n(const std::chrono::year_month_day& ymd, const compact_frequency& frequency, const int n) -> std::chrono::year_month_day
+	{
+		return _visit([&ymd, n](const auto& d) { return _advance_n(ymd, d, n); }, frequency);
+	}
+
+
+	constexpr auto _steps_between(
+		const std::chrono::year_month_day& from,
+		const std::chrono::year_month_day& to,
+		const compact_frequency& frequency
+	) -> int
+	{
+		return _visit([&from, &to](const auto& d) { return _steps_between(from, to, d); }, frequency);
+	}
+
+
+	constexpr auto is_forward(const compact_frequency& frequency) noexcept -> bool
+	{
+		return frequency.get_count() > 0;
+	}
+
+	constexpr auto is_backward(const compact_frequency& frequency) noexcept -> bool
+	{
+		return frequency.get_count() < 0;
+	}
+
+	constexpr auto negate(const compact_frequency& frequency) noexcept -> compact_frequency
+	{
+		return compact_frequency{ frequency.get_unit(), -frequency.get_count(), frequency.is_weeks_or_years() };
+	}
+
+}
@@ -0,0 +1,367 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "compounding_period.h"
+#include "day_count_interface.h"
+
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+
+namespace coupon_schedule
+{
+
+	// overnight fixings indexed by date (one element per calendar day starting from "from")
+	class overnight_fixings
+	{
+
+	public:
+
+		overnight_fixings(
+			std::chrono::sys_days from,
+			std::span<const double> rates
+		) noexcept;
+
+	public:
+
+		auto get_from() const noexcept -> std::chrono::sys_days;
+		auto get_rates() const noexcept -> std::span<const double>;
+
+		auto operator[](const std::chrono::sys_days d) const -> double; // unchecked
+
+	private:
+
+		std::chrono::sys_days _from;
+		std::span<const double> _rates;
+
+	};
+
+
+
+	class compounded_rate;
+
+
+	// everything about the compounding schedule, which does not depend on the fixings
+	// (accrual factors are immutable once built, so indices and rates share them rather than copy)
+	class compounding_weights
+	{
+
+	public:
+
+		compounding_weights(
+			std::vector<std::chrono::sys_days> resets,
+			std::vector<double> accrual_factors
+		);
+
+	public:
+
+		auto get_resets() const noexcept -> std::span<const std::chrono::sys_days>;
+		auto get_accrual_factors() const noexcept -> std::span<const double>;
+		auto get_year_fraction() const noexcept -> double;
+
+	private:
+
+		std::vector<std::chrono::sys_days> _resets;
+		std::shared_ptr<const std::vector<double>> _accrual_factors;
+		double _year_fraction;
+
+		friend class compounding_index;
+		friend auto compound(const compounding_weights& w, const overnight_fixings& f) -> compounded_rate;
+
+	};
+
+
+
+	// resets as offsets into a fixings array starting on a particular date
+	// (built once, so revaluing under many sets of fixings is just a gather and a product)
+	class compounding_index
+	{
+
+	public:
+
+		compounding_index(
+			const compounding_weights& w,
+			std::chrono::sys_days from
+		);
+
+	public:
+
+		auto get_from() const noexcept -> std::chrono::sys_days;
+		auto get_offsets() const noexcept -> std::span<const std::int32_t>;
+		auto get_accrual_factors() const noexcept -> std::span<const double>;
+		auto get_year_fraction() const noexcept -> double;
+
+	private:
+
+		std::chrono::sys_days _from;
+		std::vector<std::int32_t> _offsets;
+		std::shared_ptr<const std::vector<double>> _accrual_factors;
+		double _year_fraction;
+
+		friend auto compound(const compounding_index& index, std::span<const double> rates) -> compounded_rate;
+
+	};
+
+
+
+	class compounded_rate
+	{
+
+	public:
+
+		compounded_rate(
+			double rate,
+			double year_fraction,
+			std::shared_ptr<const std::vector<double>> accrual_factors
+		) noexcept;
+
+	public:
+
+		auto get_rate() const noexcept -> double;
+		auto get_year_fraction() const noexcept -> double;
+		auto get_accrual_factors() const noexcept -> std::span<const double>;
+
+	private:
+
+		double _rate;
+		double _year_fraction;
+		std::shared_ptr<const std::vector<double>> _accrual_factors;
+
+	};
+
+
+
+	inline overnight_fixings::overnight_fixings(
+		std::chrono::sys_days from,
+		std::span<const double> rates
+	) noexcept :
+		_from{ std::move(from) },
+		_rates{ std::move(rates) }
+	{
+	}
+
+
+	inline auto overnight_fixings::get_from() const noexcept -> std::chrono::sys_days
+	{
+		return _from;
+	}
+
+
+	inline auto overnight_fixings::get_rates() const noexcept -> std::span<const double>
+	{
+		return _rates;
+	}
+
+
+	inline auto overnight_fixings::operator[](const std::chrono::sys_days d) const -> double
+	{
+		return _rates[static_cast<std::size_t>((d - _from).count())];
+	}
+
+
+
+	inline compounding_weights::compounding_weights(
+		std::vector<std::chrono::sys_days> resets,
+		std::vector<double> accrual_factors
+	) :
+		_resets{ std::move(resets) },
+		_accrual_factors{ std::make_shared<const std::vector<double>>(std::move(accrual_factors)) },
+		_year_fraction{ 0.0 }
+	{
+		if (_resets.size() != _accrual_factors->size())
+			throw std::out_of_range{ "Number of resets and accrual factors should be the same" };
+
+		for (const auto f : *_accrual_factors)
+			_year_fraction += f;
+	}
+
+
+	inline auto compounding_weights::get_resets() const noexcept -> std::span<const std::chrono::sys_days>
+	{
+		return _resets;
+	}
+
+
+	inline auto compounding_weights::get_accrual_factors() const noexcept -> std::span<const double>
+	{
+		return *_accrual_factors;
+	}
+
+
+	inline auto compounding_weights::get_year_fraction() const noexcept -> double
+	{
+		return _year_fraction;
+	}
+
+
+
+	inline compounding_index::compounding_index(
+		const compounding_weights& w,
+		std::chrono::sys_days from
+	) :
+		_from{ std::move(from) },
+		_offsets{},
+		_accrual_factors{ w._accrual_factors },
+		_year_fraction{ w.get_year_fraction() }
+	{
+		const auto resets = w.get_resets();
+
+		if (!resets.empty() && resets.front() < _from) // resets never go backwards
+			throw std::out_of_range{ "Resets should not be before the first fixing" };
+
+		_offsets.reserve(resets.size());
+		for (const auto r : resets)
+			_offsets.push_back(static_cast<std::int32_t>((r - _from).count()));
+	}
+
+
+	inline auto compounding_index::get_from() const noexcept -> std::chrono::sys_days
+	{
+		return _from;
+	}
+
+
+	inline auto compounding_index::get_offsets() const noexcept -> std::span<const std::int32_t>
+	{
+		return _offsets;
+	}
+
+
+	inline auto compounding_index::get_accrual_factors() const noexcept -> std::span<const double>
+	{
+		return *_accrual_factors;
+	}
+
+
+	inline auto compounding_index::get_year_fraction() const noexcept -> double
+	{
+		return _year_fraction;
+	}
+
+
+
+	inline compounded_rate::compounded_rate(
+		double rate,
+		double year_fraction,
+		std::shared_ptr<const std::vector<double>> accrual_factors
+	) noexcept :
+		_rate{ rate },
+		_year_fraction{ year_fraction },
+		_accrual_factors{ std::move(accrual_factors) }
+	{
+	}
+
+
+	inline auto compounded_rate::get_rate() const noexcept -> double
+	{
+		return _rate;
+	}
+
+
+	inline auto compounded_rate::get_year_fraction() const noexcept -> double
+	{
+		return _year_fraction;
+	}
+
+
+	inline auto compounded_rate::get_accrual_factors() const noexcept -> std::span<const double>
+	{
+		return *_accrual_factors;
+	}
+
+
+
+	// dc is expected to be Actual360 or Actual365Fixed (so accrual factors are n(i)/D in ISDA 2021 terms)
+	inline auto make_compounding_weights(const compounding_periods& cps, const day_count& dc) -> compounding_weights
+	{
+		auto resets = std::vector<std::chrono::sys_days>{};
+		resets.reserve(cps.size());
+
+		auto accrual_factors = std::vector<double>{};
+		accrual_factors.reserve(cps.size());
+
+		for (const auto& p : cps)
+		{
+			resets.emplace_back(p._reset);
+			accrual_factors.push_back(dc.fraction(p._period));
+		}
+
+		return compounding_weights{ std::move(resets), std::move(accrual_factors) };
+	}
+
+
+	// compounded in arrears as per ISDA 2021: [prod(1 + r(i) * n(i) / D) - 1] * D / d
+	// (rates[0] is the fixing for index.get_from(); nothing is allocated, the rate shares the accrual factors of the index)
+	inline auto compound(const compounding_index& index, std::span<const double> rates) -> compounded_rate
+	{
+		const auto offsets = index.get_offsets();
+		const auto accrual_factors = index.get_accrual_factors();
+
+		if (!offsets.empty() && static_cast<std::size_t>(offsets.back()) >= rates.size()) // offsets never go backwards
+			throw std::out_of_range{ "Fixings do not cover all resets" };
+
+		auto product = 1.0;
+		for (auto i = std::size_t{ 0 }; i < offsets.size(); ++i)
+			product *= 1.0 + rates[static_cast<std::size_t>(offsets[i])] * accrual_factors[i];
+
+		const auto year_fraction = index.get_year_fraction();
+		const auto rate = year_fraction > 0.0 ? (product - 1.0) / year_fraction : 0.0;
+
+		return compounded_rate{ rate, year_fraction, index._accrual_factors };
+	}
+
+
+	inline auto compound(const compounding_weights& w, const overnight_fixings& f) -> compounded_rate
+	{
+		const auto resets = w.get_resets();
+		const auto accrual_factors = w.get_accrual_factors();
+
+		// resets never go backwards, so it is enough to check the first and the last one
+		if (!resets.empty())
+		{
+			const auto last = f.get_from() + std::chrono::days{ f.get_rates().size() };
+			if (resets.front() < f.get_from() || resets.back() >= last)
+				throw std::out_of_range{ "Fixings do not cover all resets" };
+		}
+
+		const auto from = f.get_from();
+		const auto rates = f.get_rates();
+
+		auto product = 1.0;
+		for (auto i = std::size_t{ 0 }; i < resets.size(); ++i)
+			product *= 1.0 + rates[static_cast<std::size_t>((resets[i] - from).count())] * accrual_factors[i];
+
+		const auto year_fraction = w.get_year_fraction();
+		const auto rate = year_fraction > 0.0 ? (product - 1.0) / year_fraction : 0.0;
+
+		return compounded_rate{ rate, year_fraction, w._accrual_factors };
+	}
+
+}
@@ -27,6 +27,7 @@
 #include <chrono>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 
 
 namespace coupon_schedule
@@ -72,6 +73,11 @@ namespace coupon_schedule
 
 	using compounding_periods = std::vector<compounding_period>; // is this the right data structure?
 
+	namespace pmr
+	{
+		using compounding_periods = std::pmr::vector<compounding_period>;
+	}
+
 
 
 	inline compounding_period::compounding_period(
@@ -24,6 +24,8 @@
 
 #include "compounding_period.h"
 #include "coupon_period.h"
+#include "business_day_index.h"
+#include "good_day_table.h"
 
 #include <period.h>
 #include <calendar.h>
@@ -31,82 +33,216 @@
 
 #include <chrono>
 #include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <iterator>
+#include <memory_resource>
 
 
 namespace coupon_schedule
 {
 
-	inline auto make_overnight_maturity(
+	// (publication is a calendar, a business_day_index or a good_day_table)
+	template<business_day_lookup C>
+	auto make_overnight_maturity(
 		const std::chrono::year_month_day& effective,
-		const gregorian::calendar& publication
+		const C& publication
 	) -> std::chrono::year_month_day
 	{
-		return gregorian::Following.adjust(
-			std::chrono::sys_days{ effective } + std::chrono::days{ 1 },
-			publication
-		);
+		return _following(std::chrono::sys_days{ effective } + std::chrono::days{ 1 }, publication);
 	}
 
-	inline auto make_overnight_effective(
+	template<business_day_lookup C>
+	auto make_overnight_effective(
 		const std::chrono::year_month_day& maturity,
-		const gregorian::calendar& publication
+		const C& publication
 	) -> std::chrono::year_month_day
 	{
-		return gregorian::Preceding.adjust(
-			std::chrono::sys_days{ maturity } - std::chrono::days{ 1 },
-			publication
-		);
+		return _preceding(std::chrono::sys_days{ maturity } - std::chrono::days{ 1 }, publication);
 	}
 	// or should we do from/until instead of effective/maturity?
 
 
-	// naive, recursive implementation for now
-	inline auto _make_compounding_schedule(const coupon_period& cp, const gregorian::calendar& c) -> compounding_periods
+	inline auto _compounding_periods_capacity(
+		const std::chrono::year_month_day& s,
+		const std::chrono::year_month_day& e
+	) -> std::size_t
+	{
+		// there can not be more compounding periods than calendar days (and we always have at least 1)
+		const auto dur = std::chrono::sys_days{ e } - std::chrono::sys_days{ s };
+		return static_cast<std::size_t>(std::max(dur.count(), decltype(dur.count()){ 1 }));
+	}
+
+
+	// single pass over the business days, which also sets reset dates
+	// (result is passed in empty, so that the caller can choose where the memory comes from)
+	template<business_day_lookup Cal, typename C = compounding_periods>
+	auto _make_compounding_schedule(const coupon_period& cp, const Cal& c, C result = C{}) -> C
 	{
 		const auto& s = cp.get_accrual_start_date();
 		const auto& e = cp.get_accrual_end_date();
 
-		const auto effective = s;
-		const auto maturity = make_overnight_maturity(effective, c);
-		if (maturity < e)
+		result.reserve(_compounding_periods_capacity(s, e));
+
+		auto effective = s;
+		auto reset = _preceding(effective, c); // only the first effective date might not be a good business day
+		for (auto maturity = make_overnight_maturity(effective, c); maturity < e; maturity = make_overnight_maturity(effective, c))
 		{
-			auto result = _make_compounding_schedule(
-				coupon_period{ gregorian::period{ maturity, e }, cp.get_pay_date(), cp.get_ex_div_date() },
-				c
-			);
-
-			result.emplace(
-				result.begin(),
-				gregorian::period{ effective, maturity },
-				std::chrono::year_month_day{}
-			);
-
-			return result;
+			result.emplace_back(gregorian::period{ effective, maturity }, reset);
+
+			effective = maturity;
+			reset = maturity; // maturity is always a good business day
 		}
-		else
-		{
-			auto result = compounding_periods{};
 
-			result.emplace_back(
-				gregorian::period{ s, e },
-				std::chrono::year_month_day{}
-			);
+		result.emplace_back(gregorian::period{ effective, e }, reset);
 
-			return result;
-		}
+		return result;
 	}
 	// or should it be a generic "1d" schedule adjusted for good business days? (so nothin special is needed for business days?)
 
 
 	inline auto make_compounding_schedule(const coupon_period& cp, const gregorian::calendar& c) -> compounding_periods // bad name as we are not actually creating a schedule (just a vector of periods)
 	{
-		auto result = _make_compounding_schedule(cp, c); // we assume that the compounding calendar and reset calendar are the same (is it true for SOFR?)
+		return _make_compounding_schedule(cp, c); // we assume that the compounding calendar and reset calendar are the same (is it true for SOFR?)
+	}
 
-		// adjust for good reset dates
-		for (auto& p : result)
-			p._reset = gregorian::Preceding.adjust(p._period.get_from(), c);
 
-		return result;
+	inline auto make_compounding_schedule(
+		const coupon_period& cp,
+		const gregorian::calendar& c,
+		std::pmr::memory_resource* const mr
+	) -> pmr::compounding_periods
+	{
+		return _make_compounding_schedule(cp, c, pmr::compounding_periods{ mr });
+	}
+
+
+	// a business_day_index or a good_day_table should cover the coupon period (and a few days around it)
+	template<business_day_lookup Index>
+	auto make_compounding_schedule(const coupon_period& cp, const Index& index) -> compounding_periods
+	{
+		return _make_compounding_schedule(cp, index);
 	}
 
+
+
+	// the same compounding periods as make_compounding_schedule, but produced one at a time
+	class compounding_schedule_view : public std::ranges::view_interface<compounding_schedule_view>
+	{
+
+	public:
+
+		class iterator
+		{
+
+		public:
+
+			using iterator_concept = std::forward_iterator_tag;
+			using iterator_category = std::input_iterator_tag; // as we do not return a reference
+			using value_type = compounding_period;
+			using difference_type = std::ptrdiff_t;
+			using reference = value_type;
+
+		private:
+
+			std::chrono::year_month_day _effective;
+			std::chrono::year_month_day _maturity;
+			std::chrono::year_month_day _reset;
+			std::chrono::year_month_day _end;
+			const gregorian::calendar* _cal = nullptr;
+			bool _done = true;
+
+		public:
+
+			iterator() noexcept = default;
+
+			explicit iterator(
+				std::chrono::year_month_day start,
+				std::chrono::year_month_day end,
+				const gregorian::calendar* const cal
+			) : _effective{ std::move(start) },
+				_maturity{},
+				_reset{ gregorian::Preceding.adjust(_effective, *cal) }, // only the first effective date might not be a good business day
+				_end{ std::move(end) },
+				_cal{ cal },
+				_done{ false }
+			{
+				_maturity = _next_maturity();
+			}
+
+			auto operator++() -> iterator&
+			{
+				if (_maturity == _end)
+					_done = true;
+				else
+				{
+					_effective = _maturity;
+					_reset = _maturity; // maturity is always a good business day
+					_maturity = _next_maturity();
+				}
+
+				return *this;
+			}
+
+			auto operator++(int) -> iterator
+			{
+				auto retval = *this;
+				++(*this);
+				return retval;
+			}
+
+			friend auto operator==(const iterator& x, const iterator& y) -> bool
+			{
+				return x._done == y._done && (x._done || x._effective == y._effective);
+			}
+
+			friend auto operator==(const iterator& x, std::default_sentinel_t) -> bool
+			{
+				return x._done;
+			}
+
+			auto operator*() const -> value_type
+			{
+				return compounding_period{ gregorian::period{ _effective, _maturity }, _reset };
+			}
+
+		private:
+
+			auto _next_maturity() const -> std::chrono::year_month_day
+			{
+				return std::min(make_overnight_maturity(_effective, *_cal), _end);
+			}
+
+		};
+
+	private:
+
+		std::chrono::year_month_day _start;
+		std::chrono::year_month_day _end;
+		const gregorian::calendar* _cal;
+
+	public:
+
+		explicit compounding_schedule_view(
+			const coupon_period& cp,
+			const gregorian::calendar& c
+		) : _start{ cp.get_accrual_start_date() },
+			_end{ cp.get_accrual_end_date() },
+			_cal{ &c }
+		{
+		}
+
+		auto begin() const
+		{
+			return iterator{ _start, _end, _cal };
+		}
+
+		auto end() const
+		{
+			return std::default_sentinel;
+		}
+
+	};
+
 }
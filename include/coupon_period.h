@@ -29,6 +29,7 @@
 #include <chrono>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 
 
 namespace coupon_schedule
@@ -93,6 +94,11 @@ namespace coupon_schedule
 
 	using coupon_periods = std::vector<coupon_period>; // is this the right data structure?
 
+	namespace pmr
+	{
+		using coupon_periods = std::pmr::vector<coupon_period>;
+	}
+
 
 
 	inline coupon_period::coupon_period(
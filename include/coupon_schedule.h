@@ -23,7 +23,9 @@
 #pragma once
 
 #include "coupon_period.h"
+#include "compact_coupon_period.h"
 #include "quasi_coupon_schedule.h"
+#include "good_day_table.h"
 
 #include <period.h>
 #include <schedule.h>
@@ -32,50 +34,167 @@
 
 #include <chrono>
 #include <memory>
+#include <ranges>
+#include <algorithm>
+#include <concepts>
+#include <utility>
+#include <cstddef>
+#include <memory_resource>
 
 
 namespace coupon_schedule
 {
 
-	inline auto _make_coupon_schedule(const gregorian::schedule& qcs) -> coupon_periods
+	// a single pass over the quasi coupon dates (a set, a vector or a lazy view), which should be sorted
+	// (they do not need to start at "from" or finish at "until")
+	// (result is passed in empty, so that the caller can choose where the memory comes from)
+	template<std::ranges::input_range R, typename F, typename C = coupon_periods>
+		requires std::convertible_to<std::ranges::range_reference_t<R>, std::chrono::year_month_day>
+	auto _make_coupon_schedule(const gregorian::days_period& from_until, R&& dates, const F& make, C result = C{}) -> C
 	{
-		auto result = coupon_periods{};
+		const auto& f = from_until.get_from();
+		const auto& u = from_until.get_until();
 
-		const auto& f = qcs.get_from_until().get_from();
-		const auto& u = qcs.get_from_until().get_until();
-		const auto& d = qcs.get_dates();
+		auto prev = f;
 
-		// naive implementation for now
-		if (f == u)
+		if constexpr (std::ranges::random_access_range<R>)
 		{
-			result.emplace_back(
-				gregorian::period{ f, u },
-				std::chrono::year_month_day{},
-				std::chrono::year_month_day{}
-			);
+			// we can find the dates in between "from" and "until" without walking them, so we know exactly how many periods are needed
+			const auto first = std::ranges::upper_bound(dates, f);
+			const auto last = std::ranges::lower_bound(first, std::ranges::end(dates), u);
+
+			result.reserve(static_cast<std::size_t>(last - first) + 1u);
+
+			for (const std::chrono::year_month_day d : std::ranges::subrange{ first, last })
+			{
+				result.push_back(make(gregorian::days_period{ prev, d }));
+				prev = d;
+			}
 		}
 		else
 		{
-			auto dates = d;
-			dates.insert(f);
-			dates.insert(u);
-
-			auto i = dates.cbegin();
-			auto prev = *i;
-			++i;
-			while (i != dates.cend())
+			// at most one too many (if neither "from" nor "until" is in the dates)
+			if constexpr (std::ranges::sized_range<R>)
+				result.reserve(std::ranges::size(dates) + 1u);
+
+			for (const std::chrono::year_month_day d : dates)
 			{
-				result.emplace_back(
-					gregorian::period{ prev, *i },
-					std::chrono::year_month_day{},
-					std::chrono::year_month_day{}
-				);
-				prev = *i;
-				++i;
+				if (d >= u)
+					break;
+				if (d > f)
+				{
+					result.push_back(make(gregorian::days_period{ prev, d }));
+					prev = d;
+				}
 			}
 		}
 
+		result.push_back(make(gregorian::days_period{ prev, u }));
+
 		return result;
 	}
 
+
+	inline auto _make_unadjusted_coupon_period(gregorian::days_period p) noexcept -> coupon_period
+	{
+		const auto e = p.get_until();
+		return coupon_period{ std::move(p), e, e };
+	}
+
+
+	// pay and ex-div dates are set to the (unadjusted) accrual end
+	template<std::ranges::input_range R>
+	auto make_coupon_schedule(const gregorian::days_period& from_until, R&& dates) -> coupon_periods
+	{
+		return _make_coupon_schedule(from_until, std::forward<R>(dates), _make_unadjusted_coupon_period);
+	}
+
+
+	template<std::ranges::input_range R>
+	auto make_coupon_schedule(
+		const gregorian::days_period& from_until,
+		R&& dates,
+		std::pmr::memory_resource* const mr
+	) -> pmr::coupon_periods
+	{
+		return _make_coupon_schedule(from_until, std::forward<R>(dates), _make_unadjusted_coupon_period, pmr::coupon_periods{ mr });
+	}
+
+
+	// pay dates are adjusted to good business days, ex-div dates are set to the (unadjusted) accrual end
+	template<std::ranges::input_range R>
+	auto make_coupon_schedule(
+		const gregorian::days_period& from_until,
+		R&& dates,
+		const gregorian::calendar& cal,
+		const gregorian::business_day_convention* const bdc = &gregorian::Following
+	) -> coupon_periods
+	{
+		return _make_coupon_schedule(from_until, std::forward<R>(dates), [&](gregorian::days_period p) {
+			return coupon_period{ std::move(p), cal, bdc };
+		});
+	}
+
+
+	template<std::ranges::input_range R>
+	auto make_coupon_schedule(
+		const gregorian::days_period& from_until,
+		R&& dates,
+		const gregorian::calendar& cal,
+		const gregorian::business_day_convention* const bdc,
+		std::pmr::memory_resource* const mr
+	) -> pmr::coupon_periods
+	{
+		const auto make = [&](gregorian::days_period p) {
+			return coupon_period{ std::move(p), cal, bdc };
+		};
+
+		return _make_coupon_schedule(from_until, std::forward<R>(dates), make, pmr::coupon_periods{ mr });
+	}
+
+
+	// the same as the calendar version, but pay dates are adjusted from a precomputed table
+	// (which supports NoAdjustment, Following, Preceding and their modified versions)
+	template<std::ranges::input_range R>
+	auto make_coupon_schedule(
+		const gregorian::days_period& from_until,
+		R&& dates,
+		const good_day_table& table,
+		const gregorian::business_day_convention* const bdc = &gregorian::Following
+	) -> coupon_periods
+	{
+		return _make_coupon_schedule(from_until, std::forward<R>(dates), [&](gregorian::days_period p) {
+			const auto e = p.get_until();
+			const auto pay = table.adjust(e, bdc);
+			return coupon_period{ std::move(p), pay, e };
+		});
+	}
+
+
+	inline auto _make_coupon_schedule(const gregorian::schedule& qcs) -> coupon_periods
+	{
+		return make_coupon_schedule(qcs.get_from_until(), qcs.get_dates());
+	}
+
+
+	inline auto _make_coupon_schedule(const gregorian::schedule& qcs, std::pmr::memory_resource* const mr) -> pmr::coupon_periods
+	{
+		return make_coupon_schedule(qcs.get_from_until(), qcs.get_dates(), mr);
+	}
+
+
+	// (the same conversion as from a coupon_period, so both ways give the same compact periods)
+	inline auto _make_unadjusted_compact_coupon_period(const gregorian::days_period& p) -> compact_coupon_period
+	{
+		const auto e = _to_sys_days(p.get_until());
+		return compact_coupon_period{ _to_sys_days(p.get_from()), e, e, e };
+	}
+
+
+	// pay and ex-div dates are set to the (unadjusted) accrual end
+	inline auto _make_compact_coupon_schedule(const gregorian::schedule& qcs) -> compact_coupon_periods
+	{
+		return _make_coupon_schedule(qcs.get_from_until(), qcs.get_dates(), _make_unadjusted_compact_coupon_period, compact_coupon_periods{});
+	}
+
 }
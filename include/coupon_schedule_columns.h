@@ -0,0 +1,300 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "coupon_period.h"
+#include "coupon_schedule.h"
+
+#include <period.h>
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <chrono>
+#include <vector>
+#include <span>
+#include <ranges>
+#include <cstddef>
+#include <utility>
+
+
+namespace coupon_schedule
+{
+
+	class coupon_schedule_columns;
+
+
+	// looks like a coupon_period, but refers to a row of coupon_schedule_columns
+	class coupon_period_reference
+	{
+
+	public:
+
+		coupon_period_reference(const coupon_schedule_columns& columns, std::size_t i) noexcept;
+
+	public:
+
+		friend auto operator==(const coupon_period_reference& r1, const coupon_period_reference& r2) noexcept -> bool;
+
+	public:
+
+		auto get_period() const -> gregorian::days_period; // not stored, so we have to make one
+		auto get_pay_date() const noexcept -> const std::chrono::year_month_day&;
+		auto get_ex_div_date() const noexcept -> const std::chrono::year_month_day&;
+
+	public:
+
+		auto get_accrual_start_date() const noexcept -> const std::chrono::year_month_day&;
+		auto get_accrual_end_date() const noexcept -> const std::chrono::year_month_day&;
+
+		auto to_coupon_period() const -> coupon_period;
+
+	private:
+
+		const coupon_schedule_columns* _columns;
+		std::size_t _i;
+
+	};
+
+
+
+	// the same information as coupon_periods, but each date is kept in its own contiguous column
+	// (so batch calculations only need to touch the dates they use)
+	class coupon_schedule_columns
+	{
+
+	public:
+
+		using dates = std::vector<std::chrono::year_month_day>;
+
+	public:
+
+		coupon_schedule_columns() noexcept = default;
+
+		explicit coupon_schedule_columns(const coupon_periods& cps);
+
+	public:
+
+		friend auto operator==(const coupon_schedule_columns& c1, const coupon_schedule_columns& c2) noexcept -> bool = default;
+
+	public:
+
+		auto get_accrual_start_dates() const noexcept -> std::span<const std::chrono::year_month_day>;
+		auto get_accrual_end_dates() const noexcept -> std::span<const std::chrono::year_month_day>;
+		auto get_pay_dates() const noexcept -> std::span<const std::chrono::year_month_day>;
+		auto get_ex_div_dates() const noexcept -> std::span<const std::chrono::year_month_day>;
+
+	public:
+
+		auto size() const noexcept -> std::size_t;
+		auto empty() const noexcept -> bool;
+
+		auto operator[](std::size_t i) const noexcept -> coupon_period_reference;
+
+		// a random access view of coupon_period_reference
+		auto periods() const;
+
+	public:
+
+		auto reserve(std::size_t n) -> void;
+		auto push_back(const coupon_period& cp) -> void;
+
+		auto to_coupon_periods() const -> coupon_periods;
+
+	private:
+
+		dates _accrual_starts;
+		dates _accrual_ends;
+		dates _pays;
+		dates _ex_divs;
+
+	};
+
+
+
+	inline coupon_period_reference::coupon_period_reference(const coupon_schedule_columns& columns, std::size_t i) noexcept :
+		_columns{ &columns },
+		_i{ i }
+	{
+	}
+
+
+	inline auto operator==(const coupon_period_reference& r1, const coupon_period_reference& r2) noexcept -> bool
+	{
+		return
+			r1.get_accrual_start_date() == r2.get_accrual_start_date() &&
+			r1.get_accrual_end_date() == r2.get_accrual_end_date() &&
+			r1.get_pay_date() == r2.get_pay_date() &&
+			r1.get_ex_div_date() == r2.get_ex_div_date();
+	}
+
+
+	inline auto coupon_period_reference::get_period() const -> gregorian::days_period
+	{
+		return gregorian::days_period{ get_accrual_start_date(), get_accrual_end_date() };
+	}
+
+
+	inline auto coupon_period_reference::get_pay_date() const noexcept -> const std::chrono::year_month_day&
+	{
+		return _columns->get_pay_dates()[_i];
+	}
+
+
+	inline auto coupon_period_reference::get_ex_div_date() const noexcept -> const std::chrono::year_month_day&
+	{
+		return _columns->get_ex_div_dates()[_i];
+	}
+
+
+	inline auto coupon_period_reference::get_accrual_start_date() const noexcept -> const std::chrono::year_month_day&
+	{
+		return _columns->get_accrual_start_dates()[_i];
+	}
+
+
+	inline auto coupon_period_reference::get_accrual_end_date() const noexcept -> const std::chrono::year_month_day&
+	{
+		return _columns->get_accrual_end_dates()[_i];
+	}
+
+
+	inline auto coupon_period_reference::to_coupon_period() const -> coupon_period
+	{
+		return coupon_period{ get_period(), get_pay_date(), get_ex_div_date() };
+	}
+
+
+
+	inline coupon_schedule_columns::coupon_schedule_columns(const coupon_periods& cps)
+	{
+		reserve(cps.size());
+		for (const auto& cp : cps)
+			push_back(cp);
+	}
+
+
+	inline auto coupon_schedule_columns::get_accrual_start_dates() const noexcept -> std::span<const std::chrono::year_month_day>
+	{
+		return _accrual_starts;
+	}
+
+
+	inline auto coupon_schedule_columns::get_accrual_end_dates() const noexcept -> std::span<const std::chrono::year_month_day>
+	{
+		return _accrual_ends;
+	}
+
+
+	inline auto coupon_schedule_columns::get_pay_dates() const noexcept -> std::span<const std::chrono::year_month_day>
+	{
+		return _pays;
+	}
+
+
+	inline auto coupon_schedule_columns::get_ex_div_dates() const noexcept -> std::span<const std::chrono::year_month_day>
+	{
+		return _ex_divs;
+	}
+
+
+	inline auto coupon_schedule_columns::size() const noexcept -> std::size_t
+	{
+		return _accrual_starts.size();
+	}
+
+
+	inline auto coupon_schedule_columns::empty() const noexcept -> bool
+	{
+		return _accrual_starts.empty();
+	}
+
+
+	inline auto coupon_schedule_columns::operator[](std::size_t i) const noexcept -> coupon_period_reference
+	{
+		return coupon_period_reference{ *this, i };
+	}
+
+
+	inline auto coupon_schedule_columns::periods() const
+	{
+		return
+			std::views::iota(std::size_t{ 0 }, size()) |
+			std::views::transform([this](const std::size_t i) { return (*this)[i]; });
+	}
+
+
+	inline auto coupon_schedule_columns::reserve(std::size_t n) -> void
+	{
+		_accrual_starts.reserve(n);
+		_accrual_ends.reserve(n);
+		_pays.reserve(n);
+		_ex_divs.reserve(n);
+	}
+
+
+	inline auto coupon_schedule_columns::push_back(const coupon_period& cp) -> void
+	{
+		_accrual_starts.push_back(cp.get_accrual_start_date());
+		_accrual_ends.push_back(cp.get_accrual_end_date());
+		_pays.push_back(cp.get_pay_date());
+		_ex_divs.push_back(cp.get_ex_div_date());
+	}
+
+
+	inline auto coupon_schedule_columns::to_coupon_periods() const -> coupon_periods
+	{
+		auto result = coupon_periods{};
+		result.reserve(size());
+		for (const auto& r : periods())
+			result.push_back(r.to_coupon_period());
+
+		return result;
+	}
+
+
+
+	// straight from the quasi coupon dates (see make_coupon_schedule), without making coupon_periods first
+	template<std::ranges::input_range R>
+	auto make_coupon_schedule_columns(const gregorian::days_period& from_until, R&& dates) -> coupon_schedule_columns
+	{
+		return _make_coupon_schedule(from_until, std::forward<R>(dates), _make_unadjusted_coupon_period, coupon_schedule_columns{});
+	}
+
+
+	template<std::ranges::input_range R>
+	auto make_coupon_schedule_columns(
+		const gregorian::days_period& from_until,
+		R&& dates,
+		const gregorian::calendar& cal,
+		const gregorian::business_day_convention* const bdc = &gregorian::Following
+	) -> coupon_schedule_columns
+	{
+		const auto make = [&](gregorian::days_period p) {
+			return coupon_period{ std::move(p), cal, bdc };
+		};
+
+		return _make_coupon_schedule(from_until, std::forward<R>(dates), make, coupon_schedule_columns{});
+	}
+
+}
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "date_adjuster_interface.h"
+#include "compact_frequency.h"
 
 #include <chrono>
 
@@ -66,32 +67,17 @@ namespace coupon_schedule
 
 
 
-	inline auto _adjust_forward_not_after_quasi_coupon_date(
+	// the quasi coupon date on the strip through the anchor, which is not past ymd in the direction of the frequency
+	// (it does not matter if the anchor is before or after ymd, so both adjusters end up here)
+	// (frequency is a compact_frequency or a single chrono duration, like the ones from fixed_frequency)
+	template<typename D>
+	constexpr auto _adjust_quasi_coupon_date(
 		const std::chrono::year_month_day& ymd,
-		const duration_variant& frequency,
+		const D& frequency,
 		const std::chrono::year_month_day& anchor
 	) -> std::chrono::year_month_day
 	{
-		auto d = anchor; // for now assume that anchor is before ymd
-
-		while (advance(d, frequency) <= ymd)
-			d = advance(d, frequency);
-
-		return d;
-	}
-
-	inline auto _adjust_backward_not_after_quasi_coupon_date(
-		const std::chrono::year_month_day& ymd,
-		const duration_variant& frequency,
-		const std::chrono::year_month_day& anchor
-	) -> std::chrono::year_month_day
-	{
-		auto d = anchor; // for now assume that anchor is before ymd
-
-		while (advance(d, frequency) >= ymd)
-			d = advance(d, frequency);
-
-		return d;
+		return _advance_n(anchor, frequency, _steps_between(anchor, ymd, frequency));
 	}
 
 	inline auto not_after_quasi_coupon_date::_adjust(
@@ -100,41 +86,10 @@ namespace coupon_schedule
 		const std::chrono::year_month_day& anchor
 	) const -> std::chrono::year_month_day
 	{
-		if(is_forward(frequency))
-			return _adjust_forward_not_after_quasi_coupon_date(ymd, frequency, anchor);
-		else
-			return _adjust_backward_not_after_quasi_coupon_date(ymd, frequency, anchor); // also covers 0 frequency - what do we want to do there?
-	}
-
-
-
-	inline auto _adjust_forward_not_before_quasi_coupon_date(
-		const std::chrono::year_month_day& ymd,
-		const duration_variant& frequency,
-		const std::chrono::year_month_day& anchor
-	) -> std::chrono::year_month_day
-	{
-		auto d = anchor; // for now assume that anchor is after ymd
-
-		while (d > ymd)
-			d = retreat(d, frequency);
-
-		return d;
+		return _adjust_quasi_coupon_date(ymd, compact_frequency{ frequency }, anchor); // throws for 0 frequency
 	}
 
-	inline auto _adjust_backward_not_before_quasi_coupon_date(
-		const std::chrono::year_month_day& ymd,
-		const duration_variant& frequency,
-		const std::chrono::year_month_day& anchor
-	) -> std::chrono::year_month_day
-	{
-		auto d = anchor; // for now assume that anchor is after ymd
-
-		while (d < ymd)
-			d = retreat(d, frequency);
 
-		return d;
-	}
 
 	inline auto not_before_quasi_coupon_date::_adjust(
 		const std::chrono::year_month_day& ymd,
@@ -142,10 +97,7 @@ namespace coupon_schedule
 		const std::chrono::year_month_day& anchor
 	) const -> std::chrono::year_month_day
 	{
-		if (is_forward(frequency))
-			return _adjust_forward_not_before_quasi_coupon_date(ymd, frequency, anchor);
-		else
-			return _adjust_backward_not_before_quasi_coupon_date(ymd, frequency, anchor); // also covers 0 frequency - what do we want to do there?
+		return _adjust_quasi_coupon_date(ymd, compact_frequency{ frequency }, anchor); // throws for 0 frequency
 	}
 
 }
@@ -25,6 +25,8 @@
 #include <period.h>
 
 #include <chrono>
+#include <span>
+#include <cstddef>
 #include <stdexcept>
 
 
@@ -39,27 +41,225 @@ namespace coupon_schedule
 		day_count() noexcept = default;
 		virtual ~day_count() noexcept = default;
 
-		day_count(const day_count&) = delete;
-		day_count(day_count&&) noexcept = delete;
+	protected:
 
-		day_count& operator=(const day_count&) = delete;
-		day_count& operator=(day_count&&) noexcept = delete;
+		// concrete day counts are values (so they can be held by day_count_variant)
+		day_count(const day_count&) noexcept = default;
+		day_count(day_count&&) noexcept = default;
+
+		day_count& operator=(const day_count&) noexcept = default;
+		day_count& operator=(day_count&&) noexcept = default;
 
 	public:
 
 		auto fraction(const gregorian::days_period& period) const -> double; // noexcept?
 
+		// one virtual call per batch (rather than per period)
+		auto fractions(
+			std::span<const gregorian::days_period> periods,
+			std::span<double> result
+		) const -> void;
+		auto fractions(
+			std::span<const std::chrono::year_month_day> starts,
+			std::span<const std::chrono::year_month_day> ends,
+			std::span<double> result
+		) const -> void;
+
 	private:
 
 		virtual auto _fraction(const gregorian::days_period& period) const -> double = 0; // noexcept?
 
+		// by default we just call _fraction for each period (so user defined day counts only have to provide that)
+		virtual auto _fractions(
+			std::span<const gregorian::days_period> periods,
+			std::span<double> result
+		) const -> void;
+		virtual auto _fractions(
+			std::span<const std::chrono::year_month_day> starts,
+			std::span<const std::chrono::year_month_day> ends,
+			std::span<double> result
+		) const -> void;
+
 	};
 
 
 
+	// the base of the concrete day counts, which provide a private non-virtual _fraction(start, end)
+	// (so it can be inlined when the day count is known statically, see day_count_variant)
+	// and optionally _fill_fractions(start_at, end_at, result) with their own batch code
+	template<typename T>
+	class day_count_base : public day_count
+	{
+
+	public:
+
+		using day_count::fraction;
+
+		// start should not be after end (as for days_period)
+		auto fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
+
+	private:
+
+		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+
+		auto _fractions(
+			std::span<const gregorian::days_period> periods,
+			std::span<double> result
+		) const -> void final;
+		auto _fractions(
+			std::span<const std::chrono::year_month_day> starts,
+			std::span<const std::chrono::year_month_day> ends,
+			std::span<double> result
+		) const -> void final;
+
+		// start_at(i) and end_at(i) give the dates of the i-th period
+		template<typename S, typename E>
+		auto _fill(const S& start_at, const E& end_at, std::span<double> result) const -> void;
+
+		auto _self() const noexcept -> const T&;
+
+	};
+
+
+
+	// the same check as for days_period (batches of starts and ends do not construct them)
+	inline auto _check_periods(
+		std::span<const std::chrono::year_month_day> starts,
+		std::span<const std::chrono::year_month_day> ends
+	) -> void
+	{
+		for (auto i = std::size_t{ 0 }; i < starts.size(); ++i)
+			if (starts[i] > ends[i])
+				throw std::out_of_range{ "Start of a period should not be after its end" };
+	}
+
+
 	inline auto day_count::fraction(const gregorian::days_period& period) const -> double
 	{
 		return _fraction(period);
 	}
 
+
+	inline auto day_count::fractions(
+		std::span<const gregorian::days_period> periods,
+		std::span<double> result
+	) const -> void
+	{
+		if (periods.size() != result.size())
+			throw std::out_of_range{ "Number of periods and results should be the same" };
+
+		_fractions(periods, result);
+	}
+
+
+	inline auto day_count::fractions(
+		std::span<const std::chrono::year_month_day> starts,
+		std::span<const std::chrono::year_month_day> ends,
+		std::span<double> result
+	) const -> void
+	{
+		if (starts.size() != ends.size() || starts.size() != result.size())
+			throw std::out_of_range{ "Number of starts, ends and results should be the same" };
+
+		_check_periods(starts, ends);
+
+		_fractions(starts, ends, result);
+	}
+
+
+	inline auto day_count::_fractions(
+		std::span<const gregorian::days_period> periods,
+		std::span<double> result
+	) const -> void
+	{
+		for (auto i = std::size_t{ 0 }; i < periods.size(); ++i)
+			result[i] = _fraction(periods[i]);
+	}
+
+
+	inline auto day_count::_fractions(
+		std::span<const std::chrono::year_month_day> starts,
+		std::span<const std::chrono::year_month_day> ends,
+		std::span<double> result
+	) const -> void
+	{
+		for (auto i = std::size_t{ 0 }; i < starts.size(); ++i)
+			result[i] = _fraction(gregorian::days_period{ starts[i], ends[i] });
+	}
+
+
+
+
+	template<typename T>
+	auto day_count_base<T>::fraction(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) const -> double
+	{
+		if (start > end)
+			throw std::out_of_range{ "Start of a period should not be after its end" };
+
+		return _self()._fraction(start, end);
+	}
+
+
+	template<typename T>
+	auto day_count_base<T>::_fraction(const gregorian::days_period& period) const -> double
+	{
+		return _self()._fraction(period.get_from(), period.get_until());
+	}
+
+
+	template<typename T>
+	auto day_count_base<T>::_fractions(
+		std::span<const gregorian::days_period> periods,
+		std::span<double> result
+	) const -> void
+	{
+		_fill(
+			[&](const std::size_t i) { return periods[i].get_from(); },
+			[&](const std::size_t i) { return periods[i].get_until(); },
+			result
+		);
+	}
+
+
+	template<typename T>
+	auto day_count_base<T>::_fractions(
+		std::span<const std::chrono::year_month_day> starts,
+		std::span<const std::chrono::year_month_day> ends,
+		std::span<double> result
+	) const -> void
+	{
+		_fill(
+			[&](const std::size_t i) { return starts[i]; },
+			[&](const std::size_t i) { return ends[i]; },
+			result
+		);
+	}
+
+
+	template<typename T>
+	template<typename S, typename E>
+	auto day_count_base<T>::_fill(const S& start_at, const E& end_at, std::span<double> result) const -> void
+	{
+		if constexpr (requires { _self()._fill_fractions(start_at, end_at, result); })
+			_self()._fill_fractions(start_at, end_at, result);
+		else
+		{
+			for (auto i = std::size_t{ 0 }; i < result.size(); ++i)
+				result[i] = _self()._fraction(start_at(i), end_at(i));
+		}
+	}
+
+
+	template<typename T>
+	auto day_count_base<T>::_self() const noexcept -> const T&
+	{
+		return static_cast<const T&>(*this);
+	}
+
 }
@@ -0,0 +1,149 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "day_count_interface.h"
+#include "day_counts.h"
+#include "duration_variant.h"
+
+#include <period.h>
+
+#include <chrono>
+#include <variant>
+#include <concepts>
+#include <span>
+#include <cstddef>
+#include <stdexcept>
+
+
+namespace coupon_schedule
+{
+
+	// a day count, which exposes a non-virtual fraction(start, end) (see day_count_base)
+	template<typename T>
+	concept static_day_count = std::derived_from<T, day_count> && requires(
+		const T& dc,
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	)
+	{
+		{ dc.fraction(start, end) } -> std::same_as<double>;
+	};
+
+
+	using day_count_variant = std::variant<
+		one_1,
+		actual_actual,
+		actual_365_fixed,
+		actual_360,
+		thirty_360,
+		thirty_e_360,
+		thirty_e_360_isda,
+		actual_365_l,
+		calculation_252,
+		const day_count* // anything else (like user defined day counts) goes through the virtual interface
+	>;
+
+
+
+	template<static_day_count T>
+	auto fraction(
+		const T& dc,
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) -> double
+	{
+		return dc.fraction(start, end);
+	}
+
+	inline auto fraction(
+		const day_count* const dc,
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) -> double
+	{
+		return dc->fraction(gregorian::days_period{ start, end });
+	}
+
+
+	inline auto fraction(
+		const day_count_variant& dcv,
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) -> double
+	{
+		return std::visit([&](const auto& dc) { return fraction(dc, start, end); }, dcv);
+	}
+
+	inline auto fraction(const day_count_variant& dcv, const gregorian::days_period& period) -> double
+	{
+		return fraction(dcv, period.get_from(), period.get_until());
+	}
+
+
+
+	// we visit once per batch, so the loop is specialised for each day count
+	inline auto fractions(
+		const day_count_variant& dcv,
+		std::span<const gregorian::days_period> periods,
+		std::span<double> result
+	) -> void
+	{
+		if (periods.size() != result.size())
+			throw std::out_of_range{ "Number of periods and results should be the same" };
+
+		std::visit(overloaded{
+			[&](const day_count* const dc) { dc->fractions(periods, result); },
+			[&](const auto& dc) { dc.fractions(periods, result); }, // a single call per batch, so the day count's own batch code is used
+		}, dcv);
+	}
+
+	inline auto fractions(
+		const day_count_variant& dcv,
+		std::span<const std::chrono::year_month_day> starts,
+		std::span<const std::chrono::year_month_day> ends,
+		std::span<double> result
+	) -> void
+	{
+		if (starts.size() != ends.size() || starts.size() != result.size())
+			throw std::out_of_range{ "Number of starts, ends and results should be the same" };
+
+		std::visit(overloaded{
+			[&](const day_count* const dc) { dc->fractions(starts, ends, result); },
+			[&](const auto& dc) { dc.fractions(starts, ends, result); },
+		}, dcv);
+	}
+
+
+
+	// the virtual interface for whatever is held (so existing code taking day_count& keeps working)
+	inline auto get_day_count(const day_count_variant& dcv) -> const day_count&
+	{
+		return std::visit(overloaded{
+			[](const day_count* const dc) -> const day_count& { return *dc; },
+			[](const auto& dc) -> const day_count& { return dc; },
+		}, dcv);
+	}
+
+}
@@ -23,22 +23,35 @@
 #pragma once
 
 #include "day_count_interface.h"
+#include "business_day_index.h"
+#include "civil_dates.h"
+#include "thirty_360_kernels.h"
 
 #include <calendar.h>
 #include <period.h>
 
 #include <chrono>
+#include <span>
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
 
 
 namespace coupon_schedule
 {
 
-	class one_1 final : public day_count
+	class one_1 final : public day_count_base<one_1>
 	{
 
 	private:
 
-		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+		friend class day_count_base<one_1>;
+
+		auto _fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
 
 	};
 
@@ -47,12 +60,26 @@ namespace coupon_schedule
 
 
 
-	class actual_actual final : public day_count
+	class actual_actual final : public day_count_base<actual_actual>
 	{
 
 	private:
 
-		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+		friend class day_count_base<actual_actual>;
+
+		auto _fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
+
+		template<typename S, typename E>
+		auto _fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void;
+
+		// for the dates outside of the year table
+		static auto _fraction_by_dates(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) -> double;
 
 	};
 
@@ -61,12 +88,20 @@ namespace coupon_schedule
 
 
 
-	class actual_365_fixed final : public day_count
+	class actual_365_fixed final : public day_count_base<actual_365_fixed>
 	{
 
 	private:
 
-		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+		friend class day_count_base<actual_365_fixed>;
+
+		auto _fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
+
+		template<typename S, typename E>
+		auto _fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void;
 
 	};
 
@@ -75,12 +110,20 @@ namespace coupon_schedule
 
 
 
-	class actual_360 final : public day_count
+	class actual_360 final : public day_count_base<actual_360>
 	{
 
 	private:
 
-		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+		friend class day_count_base<actual_360>;
+
+		auto _fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
+
+		template<typename S, typename E>
+		auto _fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void;
 
 	};
 
@@ -89,12 +132,20 @@ namespace coupon_schedule
 
 
 
-	class thirty_360 final : public day_count
+	class thirty_360 final : public day_count_base<thirty_360>
 	{
 
 	private:
 
-		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+		friend class day_count_base<thirty_360>;
+
+		auto _fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
+
+		template<typename S, typename E>
+		auto _fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void;
 
 	};
 
@@ -103,12 +154,20 @@ namespace coupon_schedule
 
 
 
-	class thirty_e_360 final : public day_count
+	class thirty_e_360 final : public day_count_base<thirty_e_360>
 	{
 
 	private:
 
-		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+		friend class day_count_base<thirty_e_360>;
+
+		auto _fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
+
+		template<typename S, typename E>
+		auto _fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void;
 
 	};
 
@@ -117,7 +176,7 @@ namespace coupon_schedule
 
 
 
-	class thirty_e_360_isda final : public day_count
+	class thirty_e_360_isda final : public day_count_base<thirty_e_360_isda>
 	{
 
 	public:
@@ -126,7 +185,15 @@ namespace coupon_schedule
 
 	private:
 
-		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+		friend class day_count_base<thirty_e_360_isda>;
+
+		auto _fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
+
+		template<typename S, typename E>
+		auto _fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void;
 
 	private:
 
@@ -139,12 +206,20 @@ namespace coupon_schedule
 
 
 
-	class actual_365_l final : public day_count
+	class actual_365_l final : public day_count_base<actual_365_l>
 	{
 
 	private:
 
-		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+		friend class day_count_base<actual_365_l>;
+
+		auto _fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
+
+		template<typename S, typename E>
+		auto _fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void;
 
 	};
 
@@ -153,20 +228,27 @@ namespace coupon_schedule
 
 
 
-	class calculation_252 final : public day_count
+	class calculation_252 final : public day_count_base<calculation_252>
 	{
 
 	public:
 
 		explicit calculation_252(const gregorian::calendar* const cal) noexcept;
+		explicit calculation_252(const business_day_index* const index) noexcept; // for many fractions against the same calendar
 
 	private:
 
-		auto _fraction(const gregorian::days_period& period) const -> double final; // noexcept?
+		friend class day_count_base<calculation_252>;
+
+		auto _fraction(
+			const std::chrono::year_month_day& start,
+			const std::chrono::year_month_day& end
+		) const -> double; // noexcept?
 
 	private:
 
-		const gregorian::calendar* _cal;
+		const gregorian::calendar* _cal = nullptr;
+		const business_day_index* _index = nullptr;
 
 	};
 
@@ -175,32 +257,174 @@ namespace coupon_schedule
 
 
 
-	inline auto _actual(const gregorian::days_period& period) -> double
+	inline auto _actual(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) -> double
 	{
-		const auto dur = std::chrono::sys_days{ period.get_until() } - std::chrono::sys_days{ period.get_from() };
+		const auto dur = std::chrono::sys_days{ end } - std::chrono::sys_days{ start };
 		return static_cast<double>(dur.count());
 	}
 
+	inline auto _actual(const gregorian::days_period& period) -> double
+	{
+		return _actual(period.get_from(), period.get_until());
+	}
 
 
-	inline auto one_1::_fraction(const gregorian::days_period& period) const -> double
+	// in batches the dates are converted a block at a time, so that the conversion loops are vectorised
+	// (start_at(i) and end_at(i) give the dates of the i-th period, f gets both serials and both dates)
+	template<typename S, typename E, typename F>
+	auto _fill_actual_fractions(
+		const S& start_at,
+		const E& end_at,
+		std::span<double> result,
+		const F& f
+	) -> void
+	{
+		auto s = std::array<day_serial, _dates_block_size>{};
+		auto e = std::array<day_serial, _dates_block_size>{};
+
+		for (auto i = std::size_t{ 0 }; i < result.size(); i += _dates_block_size)
+		{
+			const auto n = std::min(_dates_block_size, result.size() - i);
+
+			for (auto j = std::size_t{ 0 }; j < n; ++j)
+			{
+				s[j] = to_day_serial(start_at(i + j));
+				e[j] = to_day_serial(end_at(i + j));
+			}
+
+			for (auto j = std::size_t{ 0 }; j < n; ++j)
+				result[i + j] = f(s[j], e[j], start_at(i + j), end_at(i + j));
+		}
+	}
+
+
+
+	inline auto one_1::_fraction(
+		const std::chrono::year_month_day&,
+		const std::chrono::year_month_day&
+	) const -> double
 	{
 		return 1.0;
 	}
 
 
 
-	inline auto actual_actual::_fraction(const gregorian::days_period& period) const -> double
+	// 30/360 batches split the dates into columns a block at a time and run the kernel over each block
+	template<typename S, typename E, typename K>
+	auto _fill_thirty_360_fractions(
+		const S& start_at,
+		const E& end_at,
+		std::span<double> result,
+		const K& kernel
+	) -> void
 	{
-		const auto sy = period.get_from().year();
-		const auto ey = period.get_until().year();
+		auto s = _civil_block{};
+		auto e = _civil_block{};
+
+		for (auto i = std::size_t{ 0 }; i < result.size(); i += _dates_block_size)
+		{
+			const auto n = std::min(_dates_block_size, result.size() - i);
+
+			for (auto j = std::size_t{ 0 }; j < n; ++j)
+			{
+				_load(s, j, start_at(i + j));
+				_load(e, j, end_at(i + j));
+			}
+
+			kernel(s, e, i, n, result.subspan(i, n));
+		}
+	}
+
+
+
+	// serials of 1st January for every year in the table (and for the year after the last one), so the length of a year is just a difference
+	inline constexpr auto _year_table_first = 1900;
+	inline constexpr auto _year_table_last = 2299;
+
+	inline constexpr auto _year_starts = [] {
+		auto result = std::array<day_serial, _year_table_last - _year_table_first + 2>{};
+		for (auto i = std::size_t{ 0 }; i < result.size(); ++i)
+			result[i] = _days_from_civil(_year_table_first + static_cast<int>(i), 1u, 1u);
+
+		return result;
+	}();
+
+	constexpr auto _in_year_table(const std::chrono::year& y) noexcept -> bool
+	{
+		return _year_table_first <= static_cast<int>(y) && static_cast<int>(y) <= _year_table_last;
+	}
+
+
+	// Act/Act ISDA from the serials and the table
+	// (the same floating point operations as when working with the dates, so the results are bit-identical)
+	constexpr auto _actual_actual(
+		const day_serial s,
+		const day_serial e,
+		const std::chrono::year& sy,
+		const std::chrono::year& ey
+	) noexcept -> double
+	{
+		const auto si = static_cast<std::size_t>(static_cast<int>(sy) - _year_table_first);
+		const auto ei = static_cast<std::size_t>(static_cast<int>(ey) - _year_table_first);
+
+		const auto s_length = static_cast<double>(_year_starts[si + 1u] - _year_starts[si]);
+
+		if (si == ei)
+			return static_cast<double>(e - s) / s_length;
+
+		const auto e_length = static_cast<double>(_year_starts[ei + 1u] - _year_starts[ei]);
+
+		auto result = 0.0;
+		result += static_cast<double>(_year_starts[si + 1u] - s) / s_length;
+		result += static_cast<double>(static_cast<int>(ey) - static_cast<int>(sy) - 1);
+		result += static_cast<double>(e - _year_starts[ei]) / e_length;
+
+		return result;
+	}
+
+
+
+	template<typename S, typename E>
+	auto actual_actual::_fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void
+	{
+		_fill_actual_fractions(start_at, end_at, result, [](const day_serial s, const day_serial e, const auto& start, const auto& end) {
+			if (_in_year_table(start.year()) && _in_year_table(end.year()))
+				return _actual_actual(s, e, start.year(), end.year());
+			else
+				return _fraction_by_dates(start, end);
+		});
+	}
+
+
+	inline auto actual_actual::_fraction(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) const -> double
+	{
+		if (_in_year_table(start.year()) && _in_year_table(end.year()))
+			return _actual_actual(to_day_serial(start), to_day_serial(end), start.year(), end.year());
+		else
+			return _fraction_by_dates(start, end);
+	}
+
+
+	inline auto actual_actual::_fraction_by_dates(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) -> double
+	{
+		const auto sy = start.year();
+		const auto ey = end.year();
 
 		if (sy == ey)
 		{
 			if (!sy.is_leap())
-				return _actual(period) / 365.0;
+				return _actual(start, end) / 365.0;
 			else
-				return _actual(period) / 366.0;
+				return _actual(start, end) / 366.0;
 		}
 		else
 		{
@@ -208,18 +432,18 @@ namespace coupon_schedule
 
 			const auto td1 = std::chrono::year_month_day{ sy + std::chrono::years{ 1 }, std::chrono::January, std::chrono::day{ 1u } };
 			if (!sy.is_leap())
-				result += _actual(days_period{ period.get_from(), td1 }) / 365.0;
+				result += _actual(start, td1) / 365.0;
 			else
-				result += _actual(days_period{ period.get_from(), td1 }) / 366.0;
+				result += _actual(start, td1) / 366.0;
 
 			const auto dur = ey - sy - std::chrono::years{ 1 };
 			result += static_cast<double>(dur.count());
 
 			const auto td2 = std::chrono::year_month_day{ ey, std::chrono::January, std::chrono::day{ 1u } };
 			if (!ey.is_leap())
-				result += _actual(days_period{ td2, period.get_until() }) / 365.0;
+				result += _actual(td2, end) / 365.0;
 			else
-				result += _actual(days_period{ td2, period.get_until() }) / 366.0;
+				result += _actual(td2, end) / 366.0;
 
 			return result;
 		}
@@ -227,28 +451,56 @@ namespace coupon_schedule
 
 
 
-	inline auto actual_365_fixed::_fraction(const gregorian::days_period& period) const -> double
+	template<typename S, typename E>
+	auto actual_365_fixed::_fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void
 	{
-		return _actual(period) / 365.0;
+		_fill_actual_fractions(start_at, end_at, result, [](const day_serial s, const day_serial e, const auto&, const auto&) { return static_cast<double>(e - s) / 365.0; });
 	}
 
 
+	inline auto actual_365_fixed::_fraction(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) const -> double
+	{
+		return _actual(start, end) / 365.0;
+	}
+
 
-	inline auto actual_360::_fraction(const gregorian::days_period& period) const -> double
+
+	template<typename S, typename E>
+	auto actual_360::_fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void
 	{
-		return _actual(period) / 360.0;
+		_fill_actual_fractions(start_at, end_at, result, [](const day_serial s, const day_serial e, const auto&, const auto&) { return static_cast<double>(e - s) / 360.0; });
 	}
 
 
+	inline auto actual_360::_fraction(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) const -> double
+	{
+		return _actual(start, end) / 360.0;
+	}
+
+
+
+	template<typename S, typename E>
+	auto thirty_360::_fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void
+	{
+		_fill_thirty_360_fractions(start_at, end_at, result, [](const auto& s, const auto& e, std::size_t, const std::size_t n, std::span<double> r) { _thirty_360(s, e, n, r); });
+	}
+
 
-	inline auto thirty_360::_fraction(const gregorian::days_period& period) const -> double
+	inline auto thirty_360::_fraction(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) const -> double
 	{
-		const auto& start = period.get_from();
 		auto sd = start.day();
 		const auto sm = start.month();
 		const auto sy = start.year();
 
-		const auto& end = period.get_until();
 		auto ed = end.day();
 		const auto em = end.month();
 		const auto ey = end.year();
@@ -260,7 +512,7 @@ namespace coupon_schedule
 
 		const auto nom =
 			static_cast<double>((ey - sy).count()) * 360.0 +
-			static_cast<double>((em - em).count()) * 30.0 +
+			static_cast<double>(static_cast<int>(static_cast<unsigned>(em)) - static_cast<int>(static_cast<unsigned>(sm))) * 30.0 +
 			static_cast<double>((ed - sd).count());
 
 		return nom / 360.0;
@@ -268,14 +520,22 @@ namespace coupon_schedule
 
 
 
-	inline auto thirty_e_360::_fraction(const gregorian::days_period& period) const -> double
+	template<typename S, typename E>
+	auto thirty_e_360::_fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void
+	{
+		_fill_thirty_360_fractions(start_at, end_at, result, [](const auto& s, const auto& e, std::size_t, const std::size_t n, std::span<double> r) { _thirty_e_360(s, e, n, r); });
+	}
+
+
+	inline auto thirty_e_360::_fraction(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) const -> double
 	{
-		const auto& start = period.get_from();
 		auto sd = start.day();
 		const auto sm = start.month();
 		const auto sy = start.year();
 
-		const auto& end = period.get_until();
 		auto ed = end.day();
 		const auto em = end.month();
 		const auto ey = end.year();
@@ -287,7 +547,7 @@ namespace coupon_schedule
 
 		const auto nom =
 			static_cast<double>((ey - sy).count()) * 360.0 +
-			static_cast<double>((em - em).count()) * 30.0 +
+			static_cast<double>(static_cast<int>(static_cast<unsigned>(em)) - static_cast<int>(static_cast<unsigned>(sm))) * 30.0 +
 			static_cast<double>((ed - sd).count());
 
 		return nom / 360.0;
@@ -301,14 +561,26 @@ namespace coupon_schedule
 	}
 
 
-	inline auto thirty_e_360_isda::_fraction(const gregorian::days_period& period) const -> double
+	template<typename S, typename E>
+	auto thirty_e_360_isda::_fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void
+	{
+		auto t = _civil_block{};
+		for (auto j = std::size_t{ 0 }; j < _dates_block_size; ++j)
+			_load(t, j, _termination);
+
+		_fill_thirty_360_fractions(start_at, end_at, result, [&t](const auto& s, const auto& e, std::size_t, const std::size_t n, std::span<double> r) { _thirty_e_360_isda(s, e, t, n, r); });
+	}
+
+
+	inline auto thirty_e_360_isda::_fraction(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) const -> double
 	{
-		const auto& start = period.get_from();
 		auto sd = start.day();
 		const auto sm = start.month();
 		const auto sy = start.year();
 
-		const auto& end = period.get_until();
 		auto ed = end.day();
 		const auto em = end.month();
 		const auto ey = end.year();
@@ -328,7 +600,7 @@ namespace coupon_schedule
 
 		const auto nom =
 			static_cast<double>((ey - sy).count()) * 360.0 +
-			static_cast<double>((em - em).count()) * 30.0 +
+			static_cast<double>(static_cast<int>(static_cast<unsigned>(em)) - static_cast<int>(static_cast<unsigned>(sm))) * 30.0 +
 			static_cast<double>((ed - sd).count());
 
 		return nom / 360.0;
@@ -336,11 +608,51 @@ namespace coupon_schedule
 
 
 
-	inline auto actual_365_l::_fraction(const gregorian::days_period& period) const -> double
+	// each period with its own termination date (as in a batch of different swaps)
+	inline auto thirty_e_360_isda_fractions(
+		std::span<const std::chrono::year_month_day> starts,
+		std::span<const std::chrono::year_month_day> ends,
+		std::span<const std::chrono::year_month_day> terminations,
+		std::span<double> result
+	) -> void
 	{
-		const auto denom = !period.get_until().year().is_leap() ? 365.0 : 366.0;
+		if (starts.size() != ends.size() || starts.size() != terminations.size() || starts.size() != result.size())
+			throw std::out_of_range{ "Number of starts, ends, terminations and results should be the same" };
+
+		_check_periods(starts, ends);
+
+		auto t = _civil_block{};
 
-		return _actual(period) / denom;
+		_fill_thirty_360_fractions(
+			[&](const std::size_t i) { return starts[i]; },
+			[&](const std::size_t i) { return ends[i]; },
+			result,
+			[&t, &terminations](const auto& s, const auto& e, const std::size_t i, const std::size_t n, std::span<double> r) {
+				for (auto j = std::size_t{ 0 }; j < n; ++j)
+					_load(t, j, terminations[i + j]);
+
+				_thirty_e_360_isda(s, e, t, n, r);
+			}
+		);
+	}
+
+
+
+	template<typename S, typename E>
+	auto actual_365_l::_fill_fractions(const S& start_at, const E& end_at, std::span<double> result) const -> void
+	{
+		_fill_actual_fractions(start_at, end_at, result, [](const day_serial s, const day_serial e, const auto&, const auto& end) { return static_cast<double>(e - s) / (!end.year().is_leap() ? 365.0 : 366.0); });
+	}
+
+
+	inline auto actual_365_l::_fraction(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) const -> double
+	{
+		const auto denom = !end.year().is_leap() ? 365.0 : 366.0;
+
+		return _actual(start, end) / denom;
 	}
 
 
@@ -352,9 +664,23 @@ namespace coupon_schedule
 	}
 
 
-	inline auto calculation_252::_fraction(const gregorian::days_period& period) const -> double
+	inline calculation_252::calculation_252(const business_day_index* const index) noexcept :
+		_index{ index }
+	{
+	}
+
+
+	inline auto calculation_252::_fraction(
+		const std::chrono::year_month_day& start,
+		const std::chrono::year_month_day& end
+	) const -> double
 	{
-		return static_cast<double>(_cal->count_business_days(period)) / 252.0;
+		const auto business_days = _index ?
+			_index->count_business_days(gregorian::days_period{ start, end })
+		:
+			_cal->count_business_days(gregorian::days_period{ start, end });
+
+		return static_cast<double>(business_days) / 252.0;
 	}
 
 }
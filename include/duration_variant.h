@@ -24,6 +24,8 @@
 
 #include <variant>
 #include <chrono>
+#include <stdexcept>
+#include <type_traits>
 
 
 namespace coupon_schedule
@@ -43,48 +45,139 @@ namespace coupon_schedule
     struct overloaded : Ts... { using Ts::operator()...; };
 
 
-    inline auto advance(std::chrono::year_month_day ymd, const duration_variant& dv) -> std::chrono::year_month_day
+
+    // kernels specialised for each duration (so loops over them do not need to dispatch on every step)
+
+    // months and years only move the month, so dates can be worked with as (months since year 0, day) pairs
+    constexpr auto _floor_div(const int x, const int y) noexcept -> int
+    {
+        const auto q = x / y;
+        return (x % y != 0 && (x < 0) != (y < 0)) ? q - 1 : q;
+    }
+
+    constexpr auto _month_index(const std::chrono::year_month_day& ymd) noexcept -> int
+    {
+        return static_cast<int>(ymd.year()) * 12 + static_cast<int>(static_cast<unsigned>(ymd.month())) - 1;
+    }
+
+    constexpr auto _from_month_index(const int m, const std::chrono::day& d) noexcept -> std::chrono::year_month_day
+    {
+        const auto y = _floor_div(m, 12);
+        return std::chrono::year{ y } / std::chrono::month{ static_cast<unsigned>(m - y * 12) + 1u } / d;
+    }
+
+
+    // closed form of advancing n times (n can be negative, in which case we retreat)
+    // (month and year arithmetic does not change the day, so it is exact - even for dates like 31st, which become invalid in shorter months)
+    constexpr auto _advance_n(const std::chrono::year_month_day& ymd, const std::chrono::days& ds, const int n) -> std::chrono::year_month_day
+    {
+        return std::chrono::sys_days{ ymd } + ds * n;
+    }
+
+    constexpr auto _advance_n(const std::chrono::year_month_day& ymd, const std::chrono::weeks& ws, const int n) -> std::chrono::year_month_day
+    {
+        return std::chrono::sys_days{ ymd } + ws * n;
+    }
+
+    constexpr auto _advance_n(const std::chrono::year_month_day& ymd, const std::chrono::months& ms, const int n) -> std::chrono::year_month_day
+    {
+        return _from_month_index(_month_index(ymd) + static_cast<int>(ms.count()) * n, ymd.day());
+    }
+
+    constexpr auto _advance_n(const std::chrono::year_month_day& ymd, const std::chrono::years& ys, const int n) -> std::chrono::year_month_day
+    {
+        return _from_month_index(_month_index(ymd) + static_cast<int>(ys.count()) * 12 * n, ymd.day());
+    }
+
+
+    constexpr auto _steps_between_days(
+        const std::chrono::year_month_day& from,
+        const std::chrono::year_month_day& to,
+        const int step
+    ) -> int
+    {
+        const auto diff = std::chrono::sys_days{ to } - std::chrono::sys_days{ from };
+        return _floor_div(static_cast<int>(diff.count()), step);
+    }
+
+    constexpr auto _steps_between_months(
+        const std::chrono::year_month_day& from,
+        const std::chrono::year_month_day& to,
+        const int step
+    ) -> int
+    {
+        // all dates on the strip have the same day as "from", so only months have to be counted
+        // (with the day deciding if the last month is reached or not)
+        auto diff = _month_index(to) - _month_index(from);
+        if (step > 0 && from.day() > to.day())
+            --diff;
+        else if (step < 0 && from.day() < to.day())
+            ++diff;
+
+        return _floor_div(diff, step);
+    }
+
+    template<typename D>
+    constexpr auto _steps_between(
+        const std::chrono::year_month_day& from,
+        const std::chrono::year_month_day& to,
+        const D& d
+    ) -> int
+    {
+        if (d == D::zero())
+            throw std::out_of_range{ "Empty frequency does not have steps" };
+
+        if constexpr (std::is_convertible_v<D, std::chrono::days>)
+            return _steps_between_days(from, to, static_cast<int>(std::chrono::days{ d }.count()));
+        else
+            return _steps_between_months(from, to, static_cast<int>(std::chrono::months{ d }.count()));
+    }
+
+
+
+    // the runtime frequency just dispatches onto the kernels above
+
+    constexpr auto advance(const std::chrono::year_month_day& ymd, const duration_variant& dv) -> std::chrono::year_month_day
+    {
+        return std::visit([&ymd](const auto& d) { return _advance_n(ymd, d, 1); }, dv);
+    }
+
+    constexpr auto retreat(const std::chrono::year_month_day& ymd, const duration_variant& dv) -> std::chrono::year_month_day
     {
-        std::visit(overloaded{
-            [&ymd](const std::chrono::days& ds) { ymd = std::chrono::sys_days{ ymd } + ds; },
-            [&ymd](const std::chrono::weeks& ws) { ymd = std::chrono::sys_days{ ymd } + ws; },
-            [&ymd](const std::chrono::months& ms) { ymd += ms; },
-            [&ymd](const std::chrono::years& ys) { ymd += ys; },
-        }, dv);
+        return std::visit([&ymd](const auto& d) { return _advance_n(ymd, d, -1); }, dv);
+    }
 
-        return ymd;
+    constexpr auto advance_n(const std::chrono::year_month_day& ymd, const duration_variant& dv, const int n) -> std::chrono::year_month_day
+    {
+        return std::visit([&ymd, n](const auto& d) { return _advance_n(ymd, d, n); }, dv);
     }
 
-    inline auto retreat(std::chrono::year_month_day ymd, const duration_variant& dv) -> std::chrono::year_month_day
+    // the largest n, such that advance_n(from, dv, n) does not go past "to" in the direction of dv
+    // (n is negative if "to" is behind "from")
+    constexpr auto steps_between(
+        const std::chrono::year_month_day& from,
+        const std::chrono::year_month_day& to,
+        const duration_variant& dv
+    ) -> int
     {
-        std::visit(overloaded{
-            [&ymd](const std::chrono::days& ds) { ymd = std::chrono::sys_days{ ymd } - ds; },
-            [&ymd](const std::chrono::weeks& ws) { ymd = std::chrono::sys_days{ ymd } - ws; },
-            [&ymd](const std::chrono::months& ms) { ymd -= ms; },
-            [&ymd](const std::chrono::years& ys) { ymd -= ys; },
-        }, dv);
+        return std::visit([&from, &to](const auto& d) { return _steps_between(from, to, d); }, dv);
+    }
 
-        return ymd;
+
+    constexpr auto is_forward(const duration_variant& dv) -> bool
+    {
+        return std::visit([](const auto& d) { return d > std::remove_cvref_t<decltype(d)>::zero(); }, dv);
     }
 
-    inline auto is_forward(const duration_variant& dv) -> bool
+    constexpr auto is_backward(const duration_variant& dv) -> bool
     {
-        return std::visit(overloaded{
-            [](const std::chrono::days& ds) { return ds > std::chrono::days{ 0 }; },
-            [](const std::chrono::weeks& ws) { return ws > std::chrono::weeks{ 0 }; },
-            [](const std::chrono::months& ms) { return ms > std::chrono::months{ 0 }; },
-            [](const std::chrono::years& ys) { return ys > std::chrono::years{ 0 }; },
-        }, dv);
+        return std::visit([](const auto& d) { return d < std::remove_cvref_t<decltype(d)>::zero(); }, dv);
     }
 
-    inline auto is_backward(const duration_variant& dv) -> bool
+
+    constexpr auto negate(const duration_variant& dv) -> duration_variant
     {
-        return std::visit(overloaded{
-            [](const std::chrono::days& ds) { return ds < std::chrono::days{ 0 }; },
-            [](const std::chrono::weeks& ws) { return ws < std::chrono::weeks{ 0 }; },
-            [](const std::chrono::months& ms) { return ms < std::chrono::months{ 0 }; },
-            [](const std::chrono::years& ys) { return ys < std::chrono::years{ 0 }; },
-        }, dv);
+        return std::visit([](const auto& d) { return duration_variant{ -d }; }, dv);
     }
 
 }
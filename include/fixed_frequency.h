@@ -0,0 +1,178 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "duration_variant.h"
+#include "quasi_coupon_schedule.h"
+
+#include <period.h>
+#include <schedule.h>
+
+#include <chrono>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <concepts>
+
+
+namespace coupon_schedule
+{
+
+	// frequency known at compile time, so the schedule generation does not need to dispatch on it
+	// (std::chrono durations can not be template parameters themselves, so we take the type and the count)
+	template<typename D, typename D::rep N>
+	class fixed_frequency
+	{
+
+	public:
+
+		using duration = D;
+
+	public:
+
+		static constexpr auto get_duration() noexcept -> duration
+		{
+			return duration{ N };
+		}
+
+		constexpr operator duration_variant() const noexcept
+		{
+			return duration_variant{ get_duration() };
+		}
+
+	};
+
+
+	using annualy = fixed_frequency<std::chrono::years, 1>;
+	using semi_annualy = fixed_frequency<std::chrono::months, 6>;
+	using quarterly = fixed_frequency<std::chrono::months, 3>;
+	using monthly = fixed_frequency<std::chrono::months, 1>;
+	using weekly = fixed_frequency<std::chrono::weeks, 1>;
+	using daily = fixed_frequency<std::chrono::days, 1>;
+
+
+	template<typename F>
+	concept static_frequency = requires {
+		typename F::duration;
+		{ F::get_duration() } -> std::same_as<typename F::duration>;
+	};
+
+
+
+	template<static_frequency F>
+	constexpr auto advance(const std::chrono::year_month_day& ymd, F) -> std::chrono::year_month_day
+	{
+		return _advance_n(ymd, F::get_duration(), 1);
+	}
+
+	template<static_frequency F>
+	constexpr auto retreat(const std::chrono::year_month_day& ymd, F) -> std::chrono::year_month_day
+	{
+		return _advance_n(ymd, F::get_duration(), -1);
+	}
+
+	template<static_frequency F>
+	constexpr auto advance_n(const std::chrono::year_month_day& ymd, F, const int n) -> std::chrono::year_month_day
+	{
+		return _advance_n(ymd, F::get_duration(), n);
+	}
+
+	template<static_frequency F>
+	constexpr auto steps_between(
+		const std::chrono::year_month_day& from,
+		const std::chrono::year_month_day& to,
+		F
+	) -> int
+	{
+		return _steps_between(from, to, F::get_duration());
+	}
+
+	template<static_frequency F>
+	constexpr auto is_forward(F) noexcept -> bool
+	{
+		return F::get_duration() > F::duration::zero();
+	}
+
+	template<static_frequency F>
+	constexpr auto is_backward(F) noexcept -> bool
+	{
+		return F::get_duration() < F::duration::zero();
+	}
+
+
+
+	// the same kernels as for the duration_variant, but with the duration known at compile time (so without the dispatch)
+
+	// number of dates in the quasi coupon schedule (at the moment negative durations are not supported)
+	template<static_frequency F>
+	constexpr auto quasi_coupon_dates_count(
+		const std::chrono::year_month_day& issue,
+		const std::chrono::year_month_day& maturity,
+		F,
+		const std::chrono::year_month_day& anchor
+	) -> std::size_t
+	{
+		static_assert(is_forward(F{}), "Only positive frequencies are supported");
+
+		const auto a = _adjust_quasi_coupon_date(issue, F::get_duration(), anchor);
+
+		return _quasi_coupon_dates_count(a, maturity, F::get_duration());
+	}
+
+
+	// same dates as make_quasi_coupon_schedule, but can be evaluated at compile time
+	// (N should be quasi_coupon_dates_count of the same arguments)
+	template<std::size_t N, static_frequency F>
+	constexpr auto make_quasi_coupon_dates(
+		const std::chrono::year_month_day& issue,
+		const std::chrono::year_month_day& maturity,
+		F f,
+		const std::chrono::year_month_day& anchor
+	) -> std::array<std::chrono::year_month_day, N>
+	{
+		if (quasi_coupon_dates_count(issue, maturity, f, anchor) != N)
+			throw std::out_of_range{ "Wrong number of dates for the quasi coupon schedule" };
+
+		const auto a = _adjust_quasi_coupon_date(issue, F::get_duration(), anchor);
+
+		auto result = std::array<std::chrono::year_month_day, N>{};
+		_generate_quasi_coupon_dates(a, N, F::get_duration(), result.begin());
+
+		return result;
+	}
+
+
+	template<static_frequency F>
+	auto make_quasi_coupon_schedule(
+		const gregorian::days_period& issue_maturity,
+		F,
+		const std::chrono::year_month_day& anchor
+	) -> gregorian::schedule
+	{
+		static_assert(is_forward(F{}), "Only positive frequencies are supported");
+
+		return _make_quasi_coupon_schedule(issue_maturity, F::get_duration(), anchor);
+	}
+
+}
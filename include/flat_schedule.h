@@ -0,0 +1,233 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "duration_variant.h"
+#include "date_adjusters.h"
+#include "quasi_coupon_schedule.h"
+
+#include <period.h>
+#include <schedule.h>
+
+#include <chrono>
+#include <vector>
+#include <span>
+#include <optional>
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <variant>
+#include <cstddef>
+
+
+namespace coupon_schedule
+{
+
+	// same as gregorian::schedule, but the dates are kept in a sorted vector rather than in a set
+	class flat_schedule
+	{
+
+	public:
+
+		using dates = std::vector<std::chrono::year_month_day>;
+
+	public:
+
+		flat_schedule(gregorian::days_period from_until, dates ds);
+
+	public:
+
+		friend auto operator==(const flat_schedule& s1, const flat_schedule& s2) noexcept -> bool = default;
+
+	public:
+
+		auto get_from_until() const noexcept -> const gregorian::days_period&;
+		auto get_dates() const noexcept -> const dates&;
+
+		auto contains(const std::chrono::year_month_day& d) const -> bool;
+
+		// the latest date in the schedule not after d (if any)
+		auto find_not_after(const std::chrono::year_month_day& d) const -> std::optional<std::chrono::year_month_day>;
+		// the earliest date in the schedule not before d (if any)
+		auto find_not_before(const std::chrono::year_month_day& d) const -> std::optional<std::chrono::year_month_day>;
+
+		// for code which still needs a gregorian::schedule (this has to copy, as it stores a set)
+		auto to_schedule() const -> gregorian::schedule;
+
+	private:
+
+		gregorian::days_period _from_until;
+		dates _dates;
+
+	};
+
+
+
+	inline flat_schedule::flat_schedule(gregorian::days_period from_until, dates ds) :
+		_from_until{ std::move(from_until) },
+		_dates{ std::move(ds) }
+	{
+		if (std::ranges::adjacent_find(_dates, std::ranges::greater_equal{}) != _dates.cend())
+			throw std::out_of_range{ "Dates in a flat schedule should be strictly increasing" };
+	}
+
+
+	inline auto flat_schedule::get_from_until() const noexcept -> const gregorian::days_period&
+	{
+		return _from_until;
+	}
+
+
+	inline auto flat_schedule::get_dates() const noexcept -> const dates&
+	{
+		return _dates;
+	}
+
+
+	inline auto flat_schedule::contains(const std::chrono::year_month_day& d) const -> bool
+	{
+		return std::ranges::binary_search(_dates, d);
+	}
+
+
+	inline auto flat_schedule::find_not_after(const std::chrono::year_month_day& d) const -> std::optional<std::chrono::year_month_day>
+	{
+		const auto i = std::ranges::upper_bound(_dates, d);
+		if (i == _dates.cbegin())
+			return std::nullopt;
+		else
+			return *std::ranges::prev(i);
+	}
+
+
+	inline auto flat_schedule::find_not_before(const std::chrono::year_month_day& d) const -> std::optional<std::chrono::year_month_day>
+	{
+		const auto i = std::ranges::lower_bound(_dates, d);
+		if (i == _dates.cend())
+			return std::nullopt;
+		else
+			return *i;
+	}
+
+
+	inline auto flat_schedule::to_schedule() const -> gregorian::schedule
+	{
+		// dates are sorted, so each one goes straight to the end of the set
+		auto s = gregorian::schedule::dates{};
+		std::ranges::copy(_dates, std::inserter(s, s.cend()));
+
+		return gregorian::schedule{ _from_until, std::move(s) };
+	}
+
+
+
+	inline auto _make_flat_schedule(flat_schedule::dates ds) -> flat_schedule
+	{
+		if (ds.empty())
+			throw std::out_of_range{ "Quasi coupon schedule should have at least one date" };
+
+		auto p = gregorian::days_period{ ds.front(), ds.back() };
+
+		return flat_schedule{ std::move(p), std::move(ds) };
+	}
+
+
+	// writes the dates into the caller's buffer and returns the part of it which was used
+	inline auto make_quasi_coupon_dates(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const std::chrono::year_month_day& anchor,
+		std::span<std::chrono::year_month_day> buffer
+	) -> std::span<std::chrono::year_month_day>
+	{
+		const auto f = compact_frequency{ frequency };
+
+		const auto a = _adjust_quasi_coupon_date(issue_maturity.get_from(), f, anchor);
+		const auto n = _quasi_coupon_dates_count(a, issue_maturity.get_until(), f);
+
+		if (n > buffer.size())
+			throw std::out_of_range{ "Buffer is too small for the quasi coupon schedule" };
+
+		_generate_quasi_coupon_dates(a, n, f, buffer.begin());
+
+		return buffer.first(n);
+	}
+
+
+	// at the moment negative durations are not supported
+	inline auto make_flat_quasi_coupon_schedule(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const std::chrono::year_month_day& anchor
+	) -> flat_schedule
+	{
+		return _make_flat_schedule(_make_quasi_coupon_dates(issue_maturity, frequency, anchor, flat_schedule::dates{}));
+	}
+
+
+
+	namespace experimental
+	{
+
+		inline auto make_flat_quasi_coupon_schedule(
+			const gregorian::days_period& issue_maturity,
+			const duration_variant& frequency,
+			const std::chrono::year_month_day& anchor
+		) -> flat_schedule
+		{
+			return _make_flat_schedule(_make_quasi_coupon_dates(issue_maturity, frequency, anchor, flat_schedule::dates{}));
+		}
+
+	}
+
+
+
+	inline auto make_flat_quasi_coupon_schedule(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const std::chrono::month_day& anchor
+	) -> flat_schedule
+	{
+		return experimental::make_flat_quasi_coupon_schedule(
+			issue_maturity,
+			frequency,
+			_year_month_day_anchor(issue_maturity, frequency, anchor)
+		);
+	}
+
+
+	inline auto make_flat_quasi_coupon_schedule(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const quasi_coupon_anchor& anchor
+	) -> flat_schedule
+	{
+		return std::visit(
+			[&](const auto& a) { return make_flat_quasi_coupon_schedule(issue_maturity, frequency, a); },
+			anchor
+		);
+	}
+
+}
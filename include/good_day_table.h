@@ -0,0 +1,268 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "business_day_index.h"
+
+#include <period.h>
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <chrono>
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <typeinfo>
+#include <stdexcept>
+
+
+namespace coupon_schedule
+{
+
+	// for each day in the range of a business_day_index: the next and the previous good business day
+	// (so an adjustment is a single lookup, rather than a scan of the bitmap)
+	class good_day_table
+	{
+
+	public:
+
+		explicit good_day_table(const business_day_index& index);
+
+		good_day_table(
+			const gregorian::calendar& cal,
+			gregorian::days_period from_until
+		);
+
+	public:
+
+		auto get_from_until() const noexcept -> const gregorian::days_period&;
+
+		// same as gregorian::Following and gregorian::Preceding adjustments
+		auto following(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day;
+		auto preceding(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day;
+
+		// following (preceding), unless it moves into a different month
+		auto modified_following(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day;
+		auto modified_preceding(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day;
+
+		// same as bdc->adjust(d, cal) for NoAdjustment and the 4 conventions above (throws for anything else)
+		auto adjust(
+			const std::chrono::year_month_day& d,
+			const gregorian::business_day_convention* const bdc
+		) const -> std::chrono::year_month_day;
+
+		// whole spans of dates at once
+		auto following(
+			std::span<const std::chrono::year_month_day> dates,
+			std::span<std::chrono::year_month_day> result
+		) const -> void;
+		auto preceding(
+			std::span<const std::chrono::year_month_day> dates,
+			std::span<std::chrono::year_month_day> result
+		) const -> void;
+
+	private:
+
+		using _serial = std::int32_t; // days since the epoch
+
+		static constexpr auto _none = std::numeric_limits<_serial>::min(); // no good day inside the table
+
+	private:
+
+		auto _offset(const std::chrono::year_month_day& d) const -> std::size_t;
+
+		static auto _lookup(const std::vector<_serial>& table, const std::size_t i) -> std::chrono::year_month_day;
+
+	private:
+
+		gregorian::days_period _from_until;
+		std::chrono::sys_days _from;
+
+		std::vector<_serial> _following;
+		std::vector<_serial> _preceding;
+
+	};
+
+
+
+	inline good_day_table::good_day_table(const business_day_index& index) :
+		_from_until{ index.get_from_until() },
+		_from{ _from_until.get_from() }
+	{
+		const auto size = static_cast<std::size_t>((std::chrono::sys_days{ _from_until.get_until() } - _from).count()) + 1u;
+
+		const auto serial = [this](const std::size_t i) {
+			return static_cast<_serial>((_from + std::chrono::days{ i }).time_since_epoch().count());
+		};
+
+		_following.resize(size);
+		auto next = _none;
+		for (auto i = size; i-- > 0u;)
+		{
+			if (index.is_business_day(_from + std::chrono::days{ i }))
+				next = serial(i);
+			_following[i] = next;
+		}
+
+		_preceding.resize(size);
+		auto previous = _none;
+		for (auto i = std::size_t{ 0 }; i < size; ++i)
+		{
+			if (_following[i] == serial(i)) // a good business day is its own next good business day
+				previous = serial(i);
+			_preceding[i] = previous;
+		}
+	}
+
+
+	inline good_day_table::good_day_table(
+		const gregorian::calendar& cal,
+		gregorian::days_period from_until
+	) :
+		good_day_table{ business_day_index{ cal, std::move(from_until) } }
+	{
+	}
+
+
+	inline auto good_day_table::get_from_until() const noexcept -> const gregorian::days_period&
+	{
+		return _from_until;
+	}
+
+
+	inline auto good_day_table::_offset(const std::chrono::year_month_day& d) const -> std::size_t
+	{
+		const auto i = (std::chrono::sys_days{ d } - _from).count();
+		if (i < 0 || static_cast<std::size_t>(i) >= _following.size())
+			throw std::out_of_range{ "Date is outside of the good day table" };
+
+		return static_cast<std::size_t>(i);
+	}
+
+
+	inline auto good_day_table::_lookup(const std::vector<_serial>& table, const std::size_t i) -> std::chrono::year_month_day
+	{
+		const auto s = table[i];
+		if (s == _none)
+			throw std::out_of_range{ "No good day inside the table" };
+
+		return std::chrono::sys_days{ std::chrono::days{ s } };
+	}
+
+
+	inline auto good_day_table::following(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day
+	{
+		return _lookup(_following, _offset(d));
+	}
+
+
+	inline auto good_day_table::preceding(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day
+	{
+		return _lookup(_preceding, _offset(d));
+	}
+
+
+	inline auto good_day_table::modified_following(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day
+	{
+		const auto f = following(d);
+		if (f.month() == d.month())
+			return f;
+		else
+			return preceding(d);
+	}
+
+
+	inline auto good_day_table::modified_preceding(const std::chrono::year_month_day& d) const -> std::chrono::year_month_day
+	{
+		const auto p = preceding(d);
+		if (p.month() == d.month())
+			return p;
+		else
+			return following(d);
+	}
+
+
+	inline auto good_day_table::adjust(
+		const std::chrono::year_month_day& d,
+		const gregorian::business_day_convention* const bdc
+	) const -> std::chrono::year_month_day
+	{
+		// by type, as each translation unit might have its own copy of gregorian::Following, etc.
+		const auto& t = typeid(*bdc);
+
+		if (t == typeid(gregorian::no_adjustment))
+			return d;
+		else if (t == typeid(gregorian::following))
+			return following(d);
+		else if (t == typeid(gregorian::modified_following))
+			return modified_following(d);
+		else if (t == typeid(gregorian::preceding))
+			return preceding(d);
+		else if (t == typeid(gregorian::modified_preceding))
+			return modified_preceding(d);
+		else
+			throw std::out_of_range{ "Business day convention is not supported by the good day table" };
+	}
+
+
+	inline auto good_day_table::following(
+		std::span<const std::chrono::year_month_day> dates,
+		std::span<std::chrono::year_month_day> result
+	) const -> void
+	{
+		if (dates.size() != result.size())
+			throw std::out_of_range{ "Number of dates and results should be the same" };
+
+		for (auto i = std::size_t{ 0 }; i < dates.size(); ++i)
+			result[i] = following(dates[i]);
+	}
+
+
+	inline auto good_day_table::preceding(
+		std::span<const std::chrono::year_month_day> dates,
+		std::span<std::chrono::year_month_day> result
+	) const -> void
+	{
+		if (dates.size() != result.size())
+			throw std::out_of_range{ "Number of dates and results should be the same" };
+
+		for (auto i = std::size_t{ 0 }; i < dates.size(); ++i)
+			result[i] = preceding(dates[i]);
+	}
+
+
+
+	inline auto _following(const std::chrono::year_month_day& d, const good_day_table& table) -> std::chrono::year_month_day
+	{
+		return table.following(d);
+	}
+
+	inline auto _preceding(const std::chrono::year_month_day& d, const good_day_table& table) -> std::chrono::year_month_day
+	{
+		return table.preceding(d);
+	}
+
+}
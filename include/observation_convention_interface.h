@@ -0,0 +1,81 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "compounding_period.h"
+#include "compounded_rate.h"
+#include "day_count_interface.h"
+
+#include <calendar.h>
+
+
+namespace coupon_schedule
+{
+
+	// how overnight fixings are observed for a compounding schedule (in arrears, lookback, lockout, observation shift)
+	class observation_convention
+	{
+
+	public:
+
+		observation_convention() noexcept = default;
+		virtual ~observation_convention() noexcept = default;
+
+		observation_convention(const observation_convention&) = delete;
+		observation_convention(observation_convention&&) noexcept = delete;
+
+		observation_convention& operator=(const observation_convention&) = delete;
+		observation_convention& operator=(observation_convention&&) noexcept = delete;
+
+	public:
+
+		// resets in the result never go backwards
+		auto make_weights(
+			const compounding_periods& cps,
+			const gregorian::calendar& cal,
+			const day_count& dc
+		) const -> compounding_weights;
+
+	private:
+
+		virtual auto _make_weights(
+			const compounding_periods& cps,
+			const gregorian::calendar& cal,
+			const day_count& dc
+		) const -> compounding_weights = 0;
+
+	};
+
+
+
+	inline auto observation_convention::make_weights(
+		const compounding_periods& cps,
+		const gregorian::calendar& cal,
+		const day_count& dc
+	) const -> compounding_weights
+	{
+		return _make_weights(cps, cal, dc);
+	}
+
+}
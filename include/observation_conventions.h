@@ -0,0 +1,259 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "observation_convention_interface.h"
+#include "compounding_period.h"
+#include "compounded_rate.h"
+#include "day_count_interface.h"
+
+#include <period.h>
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <chrono>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+
+namespace coupon_schedule
+{
+
+	class in_arrears final : public observation_convention
+	{
+
+	private:
+
+		auto _make_weights(
+			const compounding_periods& cps,
+			const gregorian::calendar& cal,
+			const day_count& dc
+		) const -> compounding_weights final;
+
+	};
+
+
+	const auto InArrears = in_arrears{};
+
+
+
+	// fixings are observed the given number of business days before each compounding period
+	class lookback final : public observation_convention
+	{
+
+	public:
+
+		explicit lookback(unsigned business_days) noexcept;
+
+	private:
+
+		auto _make_weights(
+			const compounding_periods& cps,
+			const gregorian::calendar& cal,
+			const day_count& dc
+		) const -> compounding_weights final;
+
+	private:
+
+		unsigned _business_days;
+
+	};
+
+
+
+	// the fixing is frozen for the last given number of compounding periods
+	class lockout final : public observation_convention
+	{
+
+	public:
+
+		explicit lockout(unsigned periods) noexcept;
+
+	private:
+
+		auto _make_weights(
+			const compounding_periods& cps,
+			const gregorian::calendar& cal,
+			const day_count& dc
+		) const -> compounding_weights final;
+
+	private:
+
+		unsigned _periods;
+
+	};
+
+
+
+	// both fixings and weights come from the observation period (shifted by the given number of business days)
+	class observation_shift final : public observation_convention
+	{
+
+	public:
+
+		explicit observation_shift(unsigned business_days) noexcept;
+
+	private:
+
+		auto _make_weights(
+			const compounding_periods& cps,
+			const gregorian::calendar& cal,
+			const day_count& dc
+		) const -> compounding_weights final;
+
+	private:
+
+		unsigned _business_days;
+
+	};
+
+
+
+	// good business day, which is the given number of business days before ymd (or on it, if ymd is good and n == 0)
+	inline auto _retreat_business_days(
+		const std::chrono::year_month_day& ymd,
+		unsigned n,
+		const gregorian::calendar& cal
+	) -> std::chrono::year_month_day
+	{
+		auto d = gregorian::Preceding.adjust(ymd, cal);
+		for (; n > 0u; --n)
+			d = gregorian::Preceding.adjust(std::chrono::sys_days{ d } - std::chrono::days{ 1 }, cal);
+
+		return d;
+	}
+
+
+
+	inline auto in_arrears::_make_weights(
+		const compounding_periods& cps,
+		const gregorian::calendar&, // resets are already on the compounding periods
+		const day_count& dc
+	) const -> compounding_weights
+	{
+		return make_compounding_weights(cps, dc);
+	}
+
+
+
+	inline lookback::lookback(unsigned business_days) noexcept :
+		_business_days{ business_days }
+	{
+	}
+
+
+	inline auto lookback::_make_weights(
+		const compounding_periods& cps,
+		const gregorian::calendar& cal,
+		const day_count& dc
+	) const -> compounding_weights
+	{
+		auto resets = std::vector<std::chrono::sys_days>{};
+		resets.reserve(cps.size());
+
+		auto accrual_factors = std::vector<double>{};
+		accrual_factors.reserve(cps.size());
+
+		for (const auto& p : cps)
+		{
+			resets.emplace_back(_retreat_business_days(p._period.get_from(), _business_days, cal));
+			accrual_factors.push_back(dc.fraction(p._period));
+		}
+
+		return compounding_weights{ std::move(resets), std::move(accrual_factors) };
+	}
+
+
+
+	inline lockout::lockout(unsigned periods) noexcept :
+		_periods{ periods }
+	{
+	}
+
+
+	inline auto lockout::_make_weights(
+		const compounding_periods& cps,
+		const gregorian::calendar&, // resets are already on the compounding periods
+		const day_count& dc
+	) const -> compounding_weights
+	{
+		auto resets = std::vector<std::chrono::sys_days>{};
+		resets.reserve(cps.size());
+
+		auto accrual_factors = std::vector<double>{};
+		accrual_factors.reserve(cps.size());
+
+		// periods from the lockout date onwards reuse the reset of the period just before it
+		const auto n = cps.size();
+		const auto locked = std::min<std::size_t>(_periods, n > 0u ? n - 1u : 0u);
+		const auto last_unlocked = n - locked - 1u;
+
+		for (auto i = std::size_t{ 0 }; i < n; ++i)
+		{
+			resets.emplace_back(i <= last_unlocked ? cps[i]._reset : cps[last_unlocked]._reset);
+			accrual_factors.push_back(dc.fraction(cps[i]._period));
+		}
+
+		return compounding_weights{ std::move(resets), std::move(accrual_factors) };
+	}
+
+
+
+	inline observation_shift::observation_shift(unsigned business_days) noexcept :
+		_business_days{ business_days }
+	{
+	}
+
+
+	inline auto observation_shift::_make_weights(
+		const compounding_periods& cps,
+		const gregorian::calendar& cal,
+		const day_count& dc
+	) const -> compounding_weights
+	{
+		auto resets = std::vector<std::chrono::sys_days>{};
+		resets.reserve(cps.size());
+
+		auto accrual_factors = std::vector<double>{};
+		accrual_factors.reserve(cps.size());
+
+		if (!cps.empty())
+		{
+			auto from = _retreat_business_days(cps.front()._period.get_from(), _business_days, cal);
+			for (const auto& p : cps)
+			{
+				const auto until = _retreat_business_days(p._period.get_until(), _business_days, cal); // the next observation period starts here
+
+				resets.emplace_back(from);
+				accrual_factors.push_back(dc.fraction(gregorian::days_period{ from, until }));
+
+				from = until;
+			}
+		}
+
+		return compounding_weights{ std::move(resets), std::move(accrual_factors) };
+	}
+
+}
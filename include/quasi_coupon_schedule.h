@@ -23,6 +23,7 @@
 #pragma once
 
 #include "duration_variant.h"
+#include "compact_frequency.h"
 #include "date_adjusters.h"
 
 #include <schedule.h>
@@ -37,6 +38,11 @@
 #include <algorithm>
 #include <memory>
 #include <stdexcept>
+#include <variant>
+#include <cstddef>
+#include <compare>
+#include <vector>
+#include <memory_resource>
 
 
 namespace coupon_schedule
@@ -53,63 +59,130 @@ namespace coupon_schedule
     constexpr auto Daily = duration_variant{ std::chrono::days{ 1 } };
 
 
-	inline auto _increase_ymd_as_needed(
-		std::chrono::year_month_day d,
-		const std::chrono::year_month_day& issue,
-		const duration_variant& frequency
-	) -> std::chrono::year_month_day
+	// how many dates are needed to go from d (on the strip) to the first date at or past the target
+	// (maturity for forward frequencies, issue for backward ones)
+	// (frequency is a compact_frequency or a single chrono duration)
+	template<typename D>
+	constexpr auto _quasi_coupon_dates_count(
+		const std::chrono::year_month_day& d,
+		const std::chrono::year_month_day& target,
+		const D& frequency
+	) -> std::size_t
 	{
-		while (advance(d, frequency) <= issue)
-			d = advance(d, frequency);
+		// the first date on the strip, which is not before the target (in the direction of the frequency), is the last one in the schedule
+		auto n = _steps_between(d, target, frequency);
+		if (_advance_n(d, frequency, n) != target)
+			++n;
 
-		return d;
+		return static_cast<std::size_t>(std::max(n, 0)) + 1u;
 	}
 
-	inline auto _decrease_ymd_as_needed(
-		std::chrono::year_month_day d,
-		const std::chrono::year_month_day& issue,
-		const duration_variant& frequency
-	) -> std::chrono::year_month_day
+
+	// dates come out already sorted, so the output does not need to search for a place to put them
+	// (frequency is a single duration here, so the loop does not dispatch on every step)
+	template<typename D, std::output_iterator<std::chrono::year_month_day> O>
+	constexpr auto _generate_quasi_coupon_dates(
+		const std::chrono::year_month_day& d,
+		const std::size_t count,
+		const D& frequency,
+		O out
+	) -> O
+	{
+		for (auto i = 0; i < static_cast<int>(count); ++i)
+			*out++ = _advance_n(d, frequency, i);
+
+		return out;
+	}
+
+	// monthly family: the month index just goes up by the same number on every step and the day never changes
+	// (so the loop is an integer increment, with the date put together only on the way out)
+	template<std::output_iterator<std::chrono::year_month_day> O>
+	constexpr auto _generate_quasi_coupon_dates(
+		const std::chrono::year_month_day& d,
+		const std::size_t count,
+		const std::chrono::months& frequency,
+		O out
+	) -> O
+	{
+		const auto day = d.day();
+		const auto step = static_cast<int>(frequency.count());
+
+		auto m = _month_index(d);
+		for (auto i = std::size_t{ 0 }; i < count; ++i, m += step)
+			*out++ = _from_month_index(m, day);
+
+		return out;
+	}
+
+	template<std::output_iterator<std::chrono::year_month_day> O>
+	constexpr auto _generate_quasi_coupon_dates(
+		const std::chrono::year_month_day& d,
+		const std::size_t count,
+		const std::chrono::years& frequency,
+		O out
+	) -> O
 	{
-		while (d > issue)
-			d = retreat(d, frequency);
+		return _generate_quasi_coupon_dates(d, count, std::chrono::months{ frequency }, std::move(out));
+	}
 
-		return d;
+	template<std::output_iterator<std::chrono::year_month_day> O>
+	constexpr auto _generate_quasi_coupon_dates(
+		const std::chrono::year_month_day& d,
+		const std::size_t count,
+		const compact_frequency& frequency,
+		O out
+	) -> O
+	{
+		return _visit(
+			[&](const auto& f) { return _generate_quasi_coupon_dates(d, count, f, std::move(out)); },
+			frequency
+		);
+	}
+
+	template<std::output_iterator<std::chrono::year_month_day> O>
+	constexpr auto _generate_quasi_coupon_dates(
+		const std::chrono::year_month_day& d,
+		const std::size_t count,
+		const duration_variant& frequency,
+		O out
+	) -> O
+	{
+		return _generate_quasi_coupon_dates(d, count, compact_frequency{ frequency }, std::move(out));
 	}
 
-	inline auto _make_quasi_coupon_schedule_storage(
-		std::chrono::year_month_day d,
+
+	template<typename D>
+	auto _make_quasi_coupon_schedule_storage(
+		const std::chrono::year_month_day& d,
 		const std::chrono::year_month_day& maturity,
-		const duration_variant& frequency
+		const D& frequency
 	) -> gregorian::schedule::dates
 	{
 		auto s = gregorian::schedule::dates{};
 
-		while (s.insert(d), d < maturity)
-			d = advance(d, frequency);
+		_generate_quasi_coupon_dates(
+			d,
+			_quasi_coupon_dates_count(d, maturity, frequency),
+			frequency,
+			std::inserter(s, s.cend())
+		);
 
 		return s;
 	}
 
 
-    // at the moment negative durations are not supported
-	inline auto make_quasi_coupon_schedule(
+	template<typename D>
+	auto _make_quasi_coupon_schedule(
 		const gregorian::days_period& issue_maturity,
-		const duration_variant& frequency,
+		const D& frequency,
 		const std::chrono::year_month_day& anchor
 	) -> gregorian::schedule
 	{
 		const auto& issue = issue_maturity.get_from();
 		const auto& maturity = issue_maturity.get_until();
 
-		auto a = anchor;
-
-		if (a < issue)
-			a = _increase_ymd_as_needed(a, issue, frequency);
-		else if (a > issue)
-			a = _decrease_ymd_as_needed(a, issue, frequency);
-		else
-			; // if a == issue no need to do anything more
+		// jump straight to the quasi coupon date not after the issue (however far away the anchor is)
+		const auto a = _adjust_quasi_coupon_date(issue, frequency, anchor);
 
 		auto s = _make_quasi_coupon_schedule_storage(a, maturity, frequency);
 
@@ -120,10 +193,62 @@ namespace coupon_schedule
 	}
 
 
+    // at the moment negative durations are not supported
+	inline auto make_quasi_coupon_schedule(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const std::chrono::year_month_day& anchor
+	) -> gregorian::schedule
+	{
+		return _make_quasi_coupon_schedule(issue_maturity, compact_frequency{ frequency }, anchor);
+	}
+
+
+	namespace pmr
+	{
+		// gregorian::schedule keeps its dates in a std::set, which can not take a memory resource
+		using quasi_coupon_dates = std::pmr::vector<std::chrono::year_month_day>;
+	}
+
+
+	// (result is passed in empty, so that the caller can choose where the memory comes from)
+	template<typename C>
+	auto _make_quasi_coupon_dates(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const std::chrono::year_month_day& anchor,
+		C result
+	) -> C
+	{
+		const auto f = compact_frequency{ frequency };
+
+		const auto a = _adjust_quasi_coupon_date(issue_maturity.get_from(), f, anchor);
+		const auto n = _quasi_coupon_dates_count(a, issue_maturity.get_until(), f);
+
+		result.reserve(n);
+		_generate_quasi_coupon_dates(a, n, f, std::back_inserter(result));
+
+		return result;
+	}
+
+
+	inline auto make_quasi_coupon_schedule(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const std::chrono::year_month_day& anchor,
+		std::pmr::memory_resource* const mr
+	) -> pmr::quasi_coupon_dates
+	{
+		return _make_quasi_coupon_dates(issue_maturity, frequency, anchor, pmr::quasi_coupon_dates{ mr });
+	}
+
+
 
 	namespace experimental
 	{
 
+        // a bounded view of count dates on the strip (anchor advanced 0, 1, ..., count - 1 times)
+        // (the k-th date does not depend on the previous ones, so we can jump around as we like)
         class quasi_coupon_schedule_view : public std::ranges::view_interface<quasi_coupon_schedule_view>
         {
 
@@ -134,29 +259,45 @@ namespace coupon_schedule
 
             public:
 
-                using iterator_category = std::input_iterator_tag; // or should we allow to move in both directions?
+                using iterator_concept = std::random_access_iterator_tag;
+                using iterator_category = std::input_iterator_tag; // as we do not return a reference
                 using value_type = std::chrono::year_month_day;
-                using difference_type = int; // is this correct?
+                using difference_type = std::ptrdiff_t;
                 using reference = value_type;
 
             private:
 
-                value_type ymd_;
-                duration_variant frequency_;
+                value_type anchor_;
+                compact_frequency frequency_;
+                difference_type k_ = 0;
 
             public:
 
-                explicit iterator(
-                    value_type ymd,
-                    duration_variant frequency
-                ) : ymd_{ std::move(ymd) },
-                    frequency_{ std::move(frequency) }
+                iterator() = default;
+
+                iterator(
+                    value_type anchor,
+                    compact_frequency frequency,
+                    difference_type k
+                ) : anchor_{ std::move(anchor) },
+                    frequency_{ frequency },
+                    k_{ k }
+                {
+                }
+
+                auto operator*() const -> value_type
                 {
+                    return _advance_n(anchor_, frequency_, static_cast<int>(k_));
+                }
+
+                auto operator[](const difference_type n) const -> value_type
+                {
+                    return *(*this + n);
                 }
 
                 auto operator++() -> iterator&
                 {
-                    ymd_ = advance(ymd_, frequency_);
+                    ++k_;
                     return *this;
                 }
 
@@ -167,39 +308,97 @@ namespace coupon_schedule
                     return retval;
                 }
 
+                auto operator--() -> iterator&
+                {
+                    --k_;
+                    return *this;
+                }
+
+                auto operator--(int) -> iterator
+                {
+                    auto retval = *this;
+                    --(*this);
+                    return retval;
+                }
+
+                auto operator+=(const difference_type n) -> iterator&
+                {
+                    k_ += n;
+                    return *this;
+                }
+
+                auto operator-=(const difference_type n) -> iterator&
+                {
+                    k_ -= n;
+                    return *this;
+                }
+
+                friend auto operator+(iterator i, const difference_type n) -> iterator
+                {
+                    return i += n;
+                }
+
+                friend auto operator+(const difference_type n, iterator i) -> iterator
+                {
+                    return i += n;
+                }
+
+                friend auto operator-(iterator i, const difference_type n) -> iterator
+                {
+                    return i -= n;
+                }
+
+                // iterators are only comparable within the same view
+                friend auto operator-(const iterator& x, const iterator& y) -> difference_type
+                {
+                    return x.k_ - y.k_;
+                }
+
                 friend auto operator==(const iterator& x, const iterator& y) -> bool
                 {
-                    return *x == *y;
+                    return x.k_ == y.k_;
                 }
 
-                auto operator*() const -> value_type
+                friend auto operator<=>(const iterator& x, const iterator& y) -> std::strong_ordering
                 {
-                    return ymd_;
+                    return x.k_ <=> y.k_;
                 }
 
             };
 
         private:
 
-            iterator begin_;
+            std::chrono::year_month_day anchor_;
+            compact_frequency frequency_;
+            std::size_t count_ = 0;
 
         public:
 
-            explicit quasi_coupon_schedule_view(
+            quasi_coupon_schedule_view() = default;
+
+            quasi_coupon_schedule_view(
                 std::chrono::year_month_day anchor,
-                duration_variant frequency
-            ) : begin_{ iterator{ std::move(anchor), std::move(frequency) } }
+                compact_frequency frequency,
+                std::size_t count
+            ) : anchor_{ std::move(anchor) },
+                frequency_{ frequency },
+                count_{ count }
             {
             }
 
-            auto begin() const
+            auto begin() const -> iterator
             {
-                return begin_;
+                return iterator{ anchor_, frequency_, 0 };
             }
 
-            auto end() const
+            auto end() const -> iterator
             {
-                return std::unreachable_sentinel;
+                return iterator{ anchor_, frequency_, static_cast<std::ptrdiff_t>(count_) };
+            }
+
+            auto size() const noexcept -> std::size_t
+            {
+                return count_;
             }
 
         };
@@ -207,7 +406,7 @@ namespace coupon_schedule
 
         inline auto _adjust_anchor(
             const gregorian::days_period& issue_maturity,
-            const duration_variant& frequency,
+            const compact_frequency& frequency,
             const std::chrono::year_month_day& anchor
         ) -> std::chrono::year_month_day
         {
@@ -216,56 +415,72 @@ namespace coupon_schedule
             const auto& issue = issue_maturity.get_from();
             const auto& maturity = issue_maturity.get_until();
 
+            // NotAfter and NotBefore end up in the same place, so there is no need to go through the virtual call
+            // (should we explicitly handle "==" case? (no adjustment needed))
             if (is_forward(frequency))
-                if (anchor <= issue) // should we explicitly handle "==" case? (no adjustment needed)
-                    return NotAfter.adjust(issue, frequency, anchor);
-                else
-                    return NotBefore.adjust(issue, frequency, anchor);
+                return _adjust_quasi_coupon_date(issue, frequency, anchor);
             else
-                if (anchor >= maturity)
-                    return NotAfter.adjust(maturity, frequency, anchor);
-                else
-                    return NotBefore.adjust(maturity, frequency, anchor);
+                return _adjust_quasi_coupon_date(maturity, frequency, anchor);
         }
 
 
         inline auto _make_quasi_coupon_schedule_forward(
             const gregorian::days_period& issue_maturity,
-            const duration_variant& frequency,
+            const compact_frequency& frequency,
             const std::chrono::year_month_day& anchor
-        )
+        ) -> quasi_coupon_schedule_view
         {
             assert(is_forward(frequency));
             assert(anchor <= issue_maturity.get_from());
 
-            const auto is_not_past_just_after = [&](const auto d) // are these "business day conventions"? (but we should call them something differently?)
-            {
-                return retreat(d, frequency) < issue_maturity.get_until();
+            // up to (and including) the first date not before maturity
+            return quasi_coupon_schedule_view{
+                anchor,
+                frequency,
+                _quasi_coupon_dates_count(anchor, issue_maturity.get_until(), frequency)
             };
-
-            return
-                quasi_coupon_schedule_view{ anchor, frequency } |
-                std::views::take_while(is_not_past_just_after);
         }
 
 
+        // dates come out in the reverse order (from maturity)
         inline auto _make_quasi_coupon_schedule_backward(
             const gregorian::days_period& issue_maturity,
-            const duration_variant& frequency,
+            const compact_frequency& frequency,
             const std::chrono::year_month_day& anchor
-        )
+        ) -> quasi_coupon_schedule_view
         {
             assert(is_backward(frequency));
             assert(anchor >= issue_maturity.get_until());
 
-            const auto is_not_past_just_after = [&](const auto d)
-            {
-                return retreat(d, frequency) > issue_maturity.get_from();
+            // down to (and including) the first date not after issue
+            return quasi_coupon_schedule_view{
+                anchor,
+                frequency,
+                _quasi_coupon_dates_count(anchor, issue_maturity.get_from(), frequency)
             };
+        }
 
-            return
-                quasi_coupon_schedule_view{ anchor, frequency } |
-                std::views::take_while(is_not_past_just_after);
+
+        // dates from issue to maturity in ascending order (whichever way the frequency goes)
+        inline auto make_quasi_coupon_schedule_view(
+            const gregorian::days_period& issue_maturity,
+            const duration_variant& frequency,
+            const std::chrono::year_month_day& anchor
+        ) -> quasi_coupon_schedule_view
+        {
+            const auto f = compact_frequency{ frequency };
+
+            if (!is_forward(f) && !is_backward(f))
+                throw std::out_of_range{ "Empty frequency does not work for quasi coupon schedule" };
+
+            const auto adjusted_anchor = _adjust_anchor(issue_maturity, f, anchor);
+
+            if (is_forward(f))
+                return _make_quasi_coupon_schedule_forward(issue_maturity, f, adjusted_anchor);
+
+            // start from the other end, so we can go forward
+            const auto backward = _make_quasi_coupon_schedule_backward(issue_maturity, f, adjusted_anchor);
+            return quasi_coupon_schedule_view{ *std::ranges::prev(backward.end()), negate(f), backward.size() };
         }
 
 
@@ -277,21 +492,13 @@ namespace coupon_schedule
             const std::chrono::year_month_day& anchor
         ) -> gregorian::schedule
         {
-            if (!is_forward(frequency) && !is_backward(frequency))
-                throw std::out_of_range{ "Empty frequency does not work for quasi coupon schedule" }; // or shold we do something else, like return some type of empty schedule
-
-            const auto adjusted_anchor = _adjust_anchor(issue_maturity, frequency, anchor);
-            // are we ok to make adjustment first and then fill the schedule generation as a separate step?
-            // (if anchor is after the issue we can adjust and generate the bit below the anchor at the same time, but then we'll have to combine this with the part above the anchor)
-
-            // alternatively we can always reverse the negative duration and always advance
-            // (we would not be able to do so for all coupon schedules, but would always work for quasi coupon schedules)
-            auto s = is_forward(frequency) ?
-                _make_quasi_coupon_schedule_forward(issue_maturity, frequency, adjusted_anchor) |
-                std::ranges::to<gregorian::schedule::dates>()
-            :
-                _make_quasi_coupon_schedule_backward(issue_maturity, frequency, adjusted_anchor) |
-                std::ranges::to<gregorian::schedule::dates>(); // do we need to reverse it?
+            // the view is in ascending order whichever way the frequency goes, so the dates can be generated forward from its first one
+            // (and then the set gets them in order)
+            const auto view = make_quasi_coupon_schedule_view(issue_maturity, frequency, anchor); // throws for empty frequency
+            const auto f = compact_frequency{ frequency };
+
+            auto s = gregorian::schedule::dates{};
+            _generate_quasi_coupon_dates(view.front(), view.size(), is_forward(f) ? f : negate(f), std::inserter(s, s.cend()));
             // can we have "to" directly to gregorian::schedule?
 
             assert(!s.empty());
@@ -300,10 +507,52 @@ namespace coupon_schedule
             return gregorian::schedule{ std::move(p), std::move(s) };
         }
 
+
+        template<typename C>
+        auto _make_quasi_coupon_dates(
+            const gregorian::days_period& issue_maturity,
+            const duration_variant& frequency,
+            const std::chrono::year_month_day& anchor,
+            C result
+        ) -> C
+        {
+            const auto view = make_quasi_coupon_schedule_view(issue_maturity, frequency, anchor);
+
+            result.reserve(view.size());
+            std::ranges::copy(view, std::back_inserter(result));
+
+            return result;
+        }
+
+
+        inline auto make_quasi_coupon_schedule(
+            const gregorian::days_period& issue_maturity,
+            const duration_variant& frequency,
+            const std::chrono::year_month_day& anchor,
+            std::pmr::memory_resource* const mr
+        ) -> pmr::quasi_coupon_dates
+        {
+            return _make_quasi_coupon_dates(issue_maturity, frequency, anchor, pmr::quasi_coupon_dates{ mr });
+        }
+
     }
 
 
 
+    // the year is taken from the end of the schedule, where the generation starts
+    inline auto _year_month_day_anchor(
+        const gregorian::days_period& issue_maturity,
+        const duration_variant& frequency,
+        const std::chrono::month_day& anchor
+    ) -> std::chrono::year_month_day
+    {
+        return is_forward(frequency) ?
+            issue_maturity.get_from().year() / anchor
+        :
+            issue_maturity.get_until().year() / anchor;
+    }
+
+
     inline auto make_quasi_coupon_schedule(
         const gregorian::days_period& issue_maturity,
         const duration_variant& frequency, // at the moment we are not thinking about tricky situations towards the end of month
@@ -312,12 +561,60 @@ namespace coupon_schedule
     {
         // we need to assert that the frequency is below 1 year here
 
-        const auto a = is_forward(frequency) ?
-            issue_maturity.get_from().year() / anchor
-        :
-            issue_maturity.get_until().year() / anchor;
+        const auto a = _year_month_day_anchor(issue_maturity, frequency, anchor);
 
         return experimental::make_quasi_coupon_schedule(issue_maturity, frequency, a);
     }
 
+
+    inline auto make_quasi_coupon_schedule(
+        const gregorian::days_period& issue_maturity,
+        const duration_variant& frequency,
+        const std::chrono::month_day& anchor,
+        std::pmr::memory_resource* const mr
+    ) -> pmr::quasi_coupon_dates
+    {
+        return experimental::make_quasi_coupon_schedule(
+            issue_maturity,
+            frequency,
+            _year_month_day_anchor(issue_maturity, frequency, anchor),
+            mr
+        );
+    }
+
+
+
+    // either a full date or just a month and a day (in which case the year is taken from issue or maturity)
+    using quasi_coupon_anchor = std::variant<
+        std::chrono::year_month_day,
+        std::chrono::month_day
+    >;
+
+
+    inline auto make_quasi_coupon_schedule(
+        const gregorian::days_period& issue_maturity,
+        const duration_variant& frequency,
+        const quasi_coupon_anchor& anchor
+    ) -> gregorian::schedule
+    {
+        return std::visit(
+            [&](const auto& a) { return make_quasi_coupon_schedule(issue_maturity, frequency, a); },
+            anchor
+        );
+    }
+
+
+    inline auto make_quasi_coupon_schedule(
+        const gregorian::days_period& issue_maturity,
+        const duration_variant& frequency,
+        const quasi_coupon_anchor& anchor,
+        std::pmr::memory_resource* const mr
+    ) -> pmr::quasi_coupon_dates
+    {
+        return std::visit(
+            [&](const auto& a) { return make_quasi_coupon_schedule(issue_maturity, frequency, a, mr); },
+            anchor
+        );
+    }
+
 }
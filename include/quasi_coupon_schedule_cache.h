@@ -0,0 +1,405 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "duration_variant.h"
+#include "quasi_coupon_schedule.h"
+
+#include <period.h>
+#include <schedule.h>
+
+#include <chrono>
+#include <memory>
+#include <variant>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <cstddef>
+#include <stdexcept>
+
+
+namespace coupon_schedule
+{
+
+	class quasi_coupon_schedule_key
+	{
+
+	public:
+
+		quasi_coupon_schedule_key(
+			gregorian::days_period issue_maturity,
+			duration_variant frequency,
+			quasi_coupon_anchor anchor
+		) noexcept;
+
+	public:
+
+		friend auto operator==(const quasi_coupon_schedule_key& k1, const quasi_coupon_schedule_key& k2) noexcept -> bool = default;
+
+	public:
+
+		auto get_issue_maturity() const noexcept -> const gregorian::days_period&;
+		auto get_frequency() const noexcept -> const duration_variant&;
+		auto get_anchor() const noexcept -> const quasi_coupon_anchor&;
+
+	private:
+
+		gregorian::days_period _issue_maturity;
+		duration_variant _frequency;
+		quasi_coupon_anchor _anchor;
+
+	};
+
+
+	struct quasi_coupon_schedule_key_hash
+	{
+		auto operator()(const quasi_coupon_schedule_key& k) const noexcept -> std::size_t;
+	};
+
+
+
+	// shared immutable schedules for (issue, maturity, frequency, anchor)
+	// readers only take a shared lock on one of the shards, eviction is "second chance" (CLOCK) within a shard
+	class quasi_coupon_schedule_cache
+	{
+
+	public:
+
+		explicit quasi_coupon_schedule_cache(
+			std::size_t capacity,
+			std::size_t shards = 16
+		);
+
+		quasi_coupon_schedule_cache(const quasi_coupon_schedule_cache&) = delete;
+		quasi_coupon_schedule_cache(quasi_coupon_schedule_cache&&) noexcept = delete;
+
+		~quasi_coupon_schedule_cache() noexcept = default;
+
+		quasi_coupon_schedule_cache& operator=(const quasi_coupon_schedule_cache&) = delete;
+		quasi_coupon_schedule_cache& operator=(quasi_coupon_schedule_cache&&) noexcept = delete;
+
+	public:
+
+		auto get(
+			const gregorian::days_period& issue_maturity,
+			const duration_variant& frequency,
+			const quasi_coupon_anchor& anchor
+		) -> std::shared_ptr<const gregorian::schedule>;
+
+		auto get(const quasi_coupon_schedule_key& key) -> std::shared_ptr<const gregorian::schedule>;
+
+	public:
+
+		auto get_hits() const noexcept -> std::size_t;
+		auto get_misses() const noexcept -> std::size_t;
+		auto get_evictions() const noexcept -> std::size_t;
+
+		auto size() const -> std::size_t;
+		auto get_capacity() const noexcept -> std::size_t;
+
+		auto clear() -> void; // does not reset the counters
+
+	private:
+
+		struct _slot
+		{
+			_slot(quasi_coupon_schedule_key k, std::shared_ptr<const gregorian::schedule> s) noexcept;
+
+			quasi_coupon_schedule_key key;
+			std::shared_ptr<const gregorian::schedule> schedule;
+			std::atomic<bool> referenced;
+		};
+
+		struct alignas(64) _shard // to avoid false sharing of the counters
+		{
+			mutable std::shared_mutex mutex;
+			std::unordered_map<quasi_coupon_schedule_key, std::size_t, quasi_coupon_schedule_key_hash> index;
+			std::deque<_slot> slots; // deque does not move the slots (which hold atomics) as it grows
+			std::size_t hand = 0;
+
+			std::atomic<std::size_t> hits = 0;
+			std::atomic<std::size_t> misses = 0;
+			std::atomic<std::size_t> evictions = 0;
+		};
+
+	private:
+
+		auto _find(_shard& shard, const quasi_coupon_schedule_key& key) const -> std::shared_ptr<const gregorian::schedule>;
+
+		auto _insert(
+			_shard& shard,
+			const quasi_coupon_schedule_key& key,
+			std::shared_ptr<const gregorian::schedule> s
+		) const -> std::shared_ptr<const gregorian::schedule>;
+
+	private:
+
+		std::size_t _shard_capacity;
+		std::vector<_shard> _shards;
+
+	};
+
+
+
+	inline quasi_coupon_schedule_key::quasi_coupon_schedule_key(
+		gregorian::days_period issue_maturity,
+		duration_variant frequency,
+		quasi_coupon_anchor anchor
+	) noexcept :
+		_issue_maturity{ std::move(issue_maturity) },
+		_frequency{ std::move(frequency) },
+		_anchor{ std::move(anchor) }
+	{
+	}
+
+
+	inline auto quasi_coupon_schedule_key::get_issue_maturity() const noexcept -> const gregorian::days_period&
+	{
+		return _issue_maturity;
+	}
+
+
+	inline auto quasi_coupon_schedule_key::get_frequency() const noexcept -> const duration_variant&
+	{
+		return _frequency;
+	}
+
+
+	inline auto quasi_coupon_schedule_key::get_anchor() const noexcept -> const quasi_coupon_anchor&
+	{
+		return _anchor;
+	}
+
+
+
+	inline auto _hash_combine(std::size_t seed, const std::size_t h) noexcept -> std::size_t
+	{
+		return seed ^ (h + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	}
+
+	inline auto _hash(const std::chrono::year_month_day& ymd) noexcept -> std::size_t
+	{
+		return std::hash<int>{}(
+			static_cast<int>(ymd.year()) * 512 +
+			static_cast<int>(static_cast<unsigned>(ymd.month())) * 32 +
+			static_cast<int>(static_cast<unsigned>(ymd.day()))
+		);
+	}
+
+	inline auto _hash(const std::chrono::month_day& md) noexcept -> std::size_t
+	{
+		return std::hash<unsigned>{}(static_cast<unsigned>(md.month()) * 32u + static_cast<unsigned>(md.day()));
+	}
+
+
+	inline auto quasi_coupon_schedule_key_hash::operator()(const quasi_coupon_schedule_key& k) const noexcept -> std::size_t
+	{
+		auto h = _hash(k.get_issue_maturity().get_from());
+		h = _hash_combine(h, _hash(k.get_issue_maturity().get_until()));
+		h = _hash_combine(h, k.get_frequency().index());
+		h = _hash_combine(h, std::visit([](const auto& f) { return std::hash<long long>{}(f.count()); }, k.get_frequency()));
+		h = _hash_combine(h, k.get_anchor().index());
+		h = _hash_combine(h, std::visit([](const auto& a) { return _hash(a); }, k.get_anchor()));
+
+		return h;
+	}
+
+
+
+	inline quasi_coupon_schedule_cache::_slot::_slot(
+		quasi_coupon_schedule_key k,
+		std::shared_ptr<const gregorian::schedule> s
+	) noexcept :
+		key{ std::move(k) },
+		schedule{ std::move(s) },
+		referenced{ false }
+	{
+	}
+
+
+
+	inline quasi_coupon_schedule_cache::quasi_coupon_schedule_cache(
+		std::size_t capacity,
+		std::size_t shards
+	) :
+		_shard_capacity{},
+		_shards(shards)
+	{
+		if (capacity == 0u || shards == 0u)
+			throw std::out_of_range{ "Cache should have some capacity and at least one shard" };
+
+		_shard_capacity = (capacity + shards - 1u) / shards;
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::get(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const quasi_coupon_anchor& anchor
+	) -> std::shared_ptr<const gregorian::schedule>
+	{
+		return get(quasi_coupon_schedule_key{ issue_maturity, frequency, anchor });
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::get(const quasi_coupon_schedule_key& key) -> std::shared_ptr<const gregorian::schedule>
+	{
+		auto& shard = _shards[quasi_coupon_schedule_key_hash{}(key) % _shards.size()];
+
+		if (auto s = _find(shard, key))
+		{
+			shard.hits.fetch_add(1u, std::memory_order_relaxed);
+			return s;
+		}
+
+		shard.misses.fetch_add(1u, std::memory_order_relaxed);
+
+		// build outside of the lock (if this throws nothing is cached)
+		auto s = std::make_shared<const gregorian::schedule>(
+			make_quasi_coupon_schedule(key.get_issue_maturity(), key.get_frequency(), key.get_anchor())
+		);
+
+		return _insert(shard, key, std::move(s));
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::get_hits() const noexcept -> std::size_t
+	{
+		auto result = std::size_t{ 0 };
+		for (const auto& shard : _shards)
+			result += shard.hits.load(std::memory_order_relaxed);
+
+		return result;
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::get_misses() const noexcept -> std::size_t
+	{
+		auto result = std::size_t{ 0 };
+		for (const auto& shard : _shards)
+			result += shard.misses.load(std::memory_order_relaxed);
+
+		return result;
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::get_evictions() const noexcept -> std::size_t
+	{
+		auto result = std::size_t{ 0 };
+		for (const auto& shard : _shards)
+			result += shard.evictions.load(std::memory_order_relaxed);
+
+		return result;
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::size() const -> std::size_t
+	{
+		auto result = std::size_t{ 0 };
+		for (const auto& shard : _shards)
+		{
+			const auto lock = std::shared_lock{ shard.mutex };
+			result += shard.index.size();
+		}
+
+		return result;
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::get_capacity() const noexcept -> std::size_t
+	{
+		return _shard_capacity * _shards.size();
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::clear() -> void
+	{
+		for (auto& shard : _shards)
+		{
+			const auto lock = std::unique_lock{ shard.mutex };
+			shard.index.clear();
+			shard.slots.clear();
+			shard.hand = 0u;
+		}
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::_find(
+		_shard& shard,
+		const quasi_coupon_schedule_key& key
+	) const -> std::shared_ptr<const gregorian::schedule>
+	{
+		const auto lock = std::shared_lock{ shard.mutex };
+
+		const auto i = shard.index.find(key);
+		if (i == shard.index.cend())
+			return nullptr;
+
+		auto& slot = shard.slots[i->second];
+		slot.referenced.store(true, std::memory_order_relaxed); // the only thing readers modify
+		return slot.schedule;
+	}
+
+
+	inline auto quasi_coupon_schedule_cache::_insert(
+		_shard& shard,
+		const quasi_coupon_schedule_key& key,
+		std::shared_ptr<const gregorian::schedule> s
+	) const -> std::shared_ptr<const gregorian::schedule>
+	{
+		const auto lock = std::unique_lock{ shard.mutex };
+
+		// somebody else might have been building the same schedule at the same time
+		if (const auto i = shard.index.find(key); i != shard.index.cend())
+			return shard.slots[i->second].schedule;
+
+		if (shard.slots.size() < _shard_capacity)
+		{
+			shard.slots.emplace_back(key, s);
+			shard.index.emplace(key, shard.slots.size() - 1u);
+			return s;
+		}
+
+		// give recently used slots a second chance
+		while (shard.slots[shard.hand].referenced.exchange(false, std::memory_order_relaxed))
+			shard.hand = (shard.hand + 1u) % shard.slots.size();
+
+		auto& slot = shard.slots[shard.hand];
+		shard.index.erase(slot.key);
+		shard.evictions.fetch_add(1u, std::memory_order_relaxed);
+
+		slot.key = key;
+		slot.schedule = s;
+		shard.index.emplace(key, shard.hand);
+
+		shard.hand = (shard.hand + 1u) % shard.slots.size();
+
+		return s;
+	}
+
+}
@@ -0,0 +1,278 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "duration_variant.h"
+#include "compact_frequency.h"
+#include "date_adjusters.h"
+#include "quasi_coupon_schedule.h"
+
+#include <period.h>
+#include <schedule.h>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <variant>
+
+
+namespace coupon_schedule
+{
+
+	// a quasi coupon schedule, which is not materialised: the k-th date is just the first date advanced k times
+	// (dates are always in ascending order, even if the schedule was generated backward from maturity)
+	class regular_schedule
+	{
+
+	public:
+
+		regular_schedule(
+			std::chrono::year_month_day first,
+			compact_frequency frequency,
+			std::size_t count
+		);
+		regular_schedule(
+			std::chrono::year_month_day first,
+			const duration_variant& frequency,
+			std::size_t count
+		);
+
+	public:
+
+		friend auto operator==(const regular_schedule& s1, const regular_schedule& s2) noexcept -> bool = default;
+
+	public:
+
+		auto get_first() const noexcept -> const std::chrono::year_month_day&;
+		auto get_frequency() const noexcept -> const compact_frequency&;
+
+		auto get_from_until() const -> gregorian::days_period;
+
+		auto size() const noexcept -> std::size_t;
+
+		auto operator[](std::size_t k) const -> std::chrono::year_month_day; // unchecked
+
+		auto contains(const std::chrono::year_month_day& d) const -> bool;
+
+		auto next_on_or_after(const std::chrono::year_month_day& d) const -> std::optional<std::chrono::year_month_day>;
+		auto previous_before(const std::chrono::year_month_day& d) const -> std::optional<std::chrono::year_month_day>;
+
+		auto to_schedule() const -> gregorian::schedule;
+
+	private:
+
+		// index of the latest date on the (infinite) strip, which is not after d
+		auto _index_not_after(const std::chrono::year_month_day& d) const -> int;
+
+	private:
+
+		std::chrono::year_month_day _first;
+		compact_frequency _frequency;
+		std::size_t _count;
+
+	};
+
+
+
+	inline regular_schedule::regular_schedule(
+		std::chrono::year_month_day first,
+		compact_frequency frequency,
+		std::size_t count
+	) :
+		_first{ std::move(first) },
+		_frequency{ frequency },
+		_count{ count }
+	{
+		if (!is_forward(_frequency))
+			throw std::out_of_range{ "Regular schedule should have a positive frequency" };
+
+		if (_count == 0u)
+			throw std::out_of_range{ "Regular schedule should have at least one date" };
+	}
+
+
+	inline regular_schedule::regular_schedule(
+		std::chrono::year_month_day first,
+		const duration_variant& frequency,
+		std::size_t count
+	) :
+		regular_schedule{ std::move(first), compact_frequency{ frequency }, count }
+	{
+	}
+
+
+	inline auto regular_schedule::get_first() const noexcept -> const std::chrono::year_month_day&
+	{
+		return _first;
+	}
+
+
+	inline auto regular_schedule::get_frequency() const noexcept -> const compact_frequency&
+	{
+		return _frequency;
+	}
+
+
+	inline auto regular_schedule::get_from_until() const -> gregorian::days_period
+	{
+		return gregorian::days_period{ _first, (*this)[_count - 1u] };
+	}
+
+
+	inline auto regular_schedule::size() const noexcept -> std::size_t
+	{
+		return _count;
+	}
+
+
+	inline auto regular_schedule::operator[](std::size_t k) const -> std::chrono::year_month_day
+	{
+		return _advance_n(_first, _frequency, static_cast<int>(k));
+	}
+
+
+	inline auto regular_schedule::_index_not_after(const std::chrono::year_month_day& d) const -> int
+	{
+		return _steps_between(_first, d, _frequency);
+	}
+
+
+	inline auto regular_schedule::contains(const std::chrono::year_month_day& d) const -> bool
+	{
+		const auto k = _index_not_after(d);
+
+		return 0 <= k && static_cast<std::size_t>(k) < _count && (*this)[k] == d;
+	}
+
+
+	inline auto regular_schedule::next_on_or_after(const std::chrono::year_month_day& d) const -> std::optional<std::chrono::year_month_day>
+	{
+		auto k = _index_not_after(d);
+		if (k < 0 || _advance_n(_first, _frequency, k) != d)
+			++k;
+
+		k = std::max(k, 0);
+
+		if (static_cast<std::size_t>(k) >= _count)
+			return std::nullopt;
+		else
+			return (*this)[k];
+	}
+
+
+	inline auto regular_schedule::previous_before(const std::chrono::year_month_day& d) const -> std::optional<std::chrono::year_month_day>
+	{
+		auto k = _index_not_after(d);
+		if (k >= 0 && _advance_n(_first, _frequency, k) == d)
+			--k;
+
+		if (k < 0)
+			return std::nullopt;
+		else
+			return (*this)[std::min(static_cast<std::size_t>(k), _count - 1u)];
+	}
+
+
+	inline auto regular_schedule::to_schedule() const -> gregorian::schedule
+	{
+		auto s = gregorian::schedule::dates{};
+		_generate_quasi_coupon_dates(_first, _count, _frequency, std::inserter(s, s.cend()));
+
+		return gregorian::schedule{ get_from_until(), std::move(s) };
+	}
+
+
+
+	// same dates as make_quasi_coupon_schedule
+	inline auto make_regular_schedule(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const std::chrono::year_month_day& anchor
+	) -> regular_schedule
+	{
+		const auto f = compact_frequency{ frequency };
+
+		const auto a = _adjust_quasi_coupon_date(issue_maturity.get_from(), f, anchor);
+		const auto n = _quasi_coupon_dates_count(a, issue_maturity.get_until(), f);
+
+		return regular_schedule{ a, f, n };
+	}
+
+
+
+	namespace experimental
+	{
+
+		// same dates as experimental::make_quasi_coupon_schedule (so the frequency can be negative)
+		inline auto make_regular_schedule(
+			const gregorian::days_period& issue_maturity,
+			const duration_variant& frequency,
+			const std::chrono::year_month_day& anchor
+		) -> regular_schedule
+		{
+			const auto view = make_quasi_coupon_schedule_view(issue_maturity, frequency, anchor);
+
+			const auto f = compact_frequency{ frequency };
+
+			return regular_schedule{
+				view.front(),
+				is_forward(f) ? f : negate(f),
+				view.size()
+			};
+		}
+
+	}
+
+
+
+	inline auto make_regular_schedule(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const std::chrono::month_day& anchor
+	) -> regular_schedule
+	{
+		return experimental::make_regular_schedule(
+			issue_maturity,
+			frequency,
+			_year_month_day_anchor(issue_maturity, frequency, anchor)
+		);
+	}
+
+
+	inline auto make_regular_schedule(
+		const gregorian::days_period& issue_maturity,
+		const duration_variant& frequency,
+		const quasi_coupon_anchor& anchor
+	) -> regular_schedule
+	{
+		return std::visit(
+			[&](const auto& a) { return make_regular_schedule(issue_maturity, frequency, a); },
+			anchor
+		);
+	}
+
+}
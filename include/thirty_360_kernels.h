@@ -0,0 +1,146 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "civil_dates.h"
+
+#include <chrono>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace coupon_schedule
+{
+
+	// 30/360 family works on the year, month and day of the dates, so in batches the dates are split into columns
+	// (and then all the clamps are selects rather than branches, so the loops over a block can be vectorised)
+
+	struct _civil_block
+	{
+		std::array<std::int32_t, _dates_block_size> y;
+		std::array<std::int32_t, _dates_block_size> m;
+		std::array<std::int32_t, _dates_block_size> d;
+	};
+
+
+	inline auto _load(_civil_block& b, const std::size_t j, const std::chrono::year_month_day& ymd) noexcept -> void
+	{
+		b.y[j] = static_cast<std::int32_t>(static_cast<int>(ymd.year()));
+		b.m[j] = static_cast<std::int32_t>(static_cast<unsigned>(ymd.month()));
+		b.d[j] = static_cast<std::int32_t>(static_cast<unsigned>(ymd.day()));
+	}
+
+
+
+	constexpr auto _is_leap(const std::int32_t y) noexcept -> std::int32_t
+	{
+		// (for centuries divisible by 400 is the same as divisible by 16, which is cheaper to check)
+		return static_cast<std::int32_t>(((y & 3) == 0) & ((y % 100 != 0) | ((y & 15) == 0)));
+	}
+
+	constexpr auto _last_day_of_month(const std::int32_t y, const std::int32_t m) noexcept -> std::int32_t
+	{
+		// 31 for January, March, May, July, August, October and December (30 for the rest, apart from February)
+		const auto d = 30 + ((m + (m >> 3)) & 1);
+		return m == 2 ? 28 + _is_leap(y) : d;
+	}
+
+	constexpr auto _thirty_360_fraction(
+		const std::int32_t sy,
+		const std::int32_t sm,
+		const std::int32_t sd,
+		const std::int32_t ey,
+		const std::int32_t em,
+		const std::int32_t ed
+	) noexcept -> double
+	{
+		const auto nom =
+			static_cast<double>(ey - sy) * 360.0 +
+			static_cast<double>(em - sm) * 30.0 +
+			static_cast<double>(ed - sd);
+
+		return nom / 360.0;
+	}
+
+
+
+	inline auto _thirty_360(
+		const _civil_block& s,
+		const _civil_block& e,
+		const std::size_t n,
+		std::span<double> result
+	) noexcept -> void
+	{
+		for (auto j = std::size_t{ 0 }; j < n; ++j)
+		{
+			// 31st becomes 30th (the end only if the start is 30th or 31st)
+			const auto sd = s.d[j] - static_cast<std::int32_t>(s.d[j] == 31);
+			const auto ed = e.d[j] - static_cast<std::int32_t>((e.d[j] == 31) & (s.d[j] >= 30));
+
+			result[j] = _thirty_360_fraction(s.y[j], s.m[j], sd, e.y[j], e.m[j], ed);
+		}
+	}
+
+	inline auto _thirty_e_360(
+		const _civil_block& s,
+		const _civil_block& e,
+		const std::size_t n,
+		std::span<double> result
+	) noexcept -> void
+	{
+		for (auto j = std::size_t{ 0 }; j < n; ++j)
+		{
+			const auto sd = s.d[j] - static_cast<std::int32_t>(s.d[j] == 31);
+			const auto ed = e.d[j] - static_cast<std::int32_t>(e.d[j] == 31);
+
+			result[j] = _thirty_360_fraction(s.y[j], s.m[j], sd, e.y[j], e.m[j], ed);
+		}
+	}
+
+	// t is the termination date of each row
+	inline auto _thirty_e_360_isda(
+		const _civil_block& s,
+		const _civil_block& e,
+		const _civil_block& t,
+		const std::size_t n,
+		std::span<double> result
+	) noexcept -> void
+	{
+		for (auto j = std::size_t{ 0 }; j < n; ++j)
+		{
+			const auto s_last = s.d[j] == _last_day_of_month(s.y[j], s.m[j]);
+			const auto e_last = e.d[j] == _last_day_of_month(e.y[j], e.m[j]);
+			const auto e_termination = (e.y[j] == t.y[j]) & (e.m[j] == t.m[j]) & (e.d[j] == t.d[j]);
+
+			// the end of February is not moved on the termination date
+			const auto sd = s_last ? 30 : s.d[j];
+			const auto ed = e_last & !(e_termination & (e.m[j] == 2)) ? 30 : e.d[j];
+
+			result[j] = _thirty_360_fraction(s.y[j], s.m[j], sd, e.y[j], e.m[j], ed);
+		}
+	}
+
+}
@@ -0,0 +1,133 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <accrued_interest.h>
+#include <coupon_period.h>
+#include <day_counts.h>
+#include <day_count_variant.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <array>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	inline auto _make_gilt_coupon_periods() -> coupon_periods
+	{
+		// ex-div dates are 7 business days before the coupon
+		return coupon_periods{
+			{ { 2023y / January / 31d, 2023y / July / 31d }, 2023y / July / 31d, 2023y / July / 20d },
+			{ { 2023y / July / 31d, 2024y / January / 31d }, 2024y / January / 31d, 2024y / January / 22d },
+			{ { 2024y / January / 31d, 2024y / July / 31d }, 2024y / July / 31d, 2024y / July / 22d },
+		};
+	}
+
+
+	TEST(accrued_interest, find_coupon_period)
+	{
+		const auto cps = _make_gilt_coupon_periods();
+
+		EXPECT_EQ(cps[0], find_coupon_period(cps, 2023y / January / 31d));
+		EXPECT_EQ(cps[0], find_coupon_period(cps, 2023y / July / 30d));
+		EXPECT_EQ(cps[1], find_coupon_period(cps, 2023y / July / 31d));
+		EXPECT_EQ(cps[2], find_coupon_period(cps, 2024y / July / 30d));
+
+		EXPECT_THROW(find_coupon_period(cps, 2023y / January / 30d), out_of_range);
+		EXPECT_THROW(find_coupon_period(cps, 2024y / July / 31d), out_of_range);
+		EXPECT_THROW(find_coupon_period(coupon_periods{}, 2024y / July / 31d), out_of_range);
+	}
+
+	TEST(accrued_interest, accrued_fraction)
+	{
+		const auto cps = _make_gilt_coupon_periods();
+		const auto dc = day_count_variant{ actual_365_fixed{} };
+
+		// cum-div
+		EXPECT_EQ(0.0, accrued_fraction(cps, 2023y / July / 31d, dc));
+		EXPECT_EQ(31.0 / 365.0, accrued_fraction(cps, 2023y / August / 31d, dc));
+		EXPECT_EQ(174.0 / 365.0, accrued_fraction(cps, 2024y / January / 21d, dc));
+
+		// ex-div
+		EXPECT_EQ(-9.0 / 365.0, accrued_fraction(cps, 2024y / January / 22d, dc));
+		EXPECT_EQ(-1.0 / 365.0, accrued_fraction(cps, 2024y / January / 30d, dc));
+
+		// from the period itself
+		EXPECT_EQ(-11.0 / 365.0, accrued_fraction(cps[0], 2023y / July / 20d, dc));
+	}
+
+	TEST(accrued_interest, accrual_schedule)
+	{
+		EXPECT_THROW((accrual_schedule{ coupon_periods{}, actual_365_fixed{} }), out_of_range);
+
+		const auto bond = accrual_schedule{ _make_gilt_coupon_periods(), actual_365_fixed{} };
+
+		EXPECT_EQ(31.0 / 365.0, bond.accrued_fraction(2023y / August / 31d));
+		EXPECT_EQ(-9.0 / 365.0, bond.accrued_fraction(2024y / January / 22d));
+	}
+
+	TEST(accrued_interest, accrued_fractions)
+	{
+		const auto gilt = accrual_schedule{ _make_gilt_coupon_periods(), actual_365_fixed{} };
+		const auto other = accrual_schedule{
+			coupon_periods{ { { 2023y / January / 15d, 2024y / January / 15d }, 2024y / January / 15d, 2024y / January / 15d } },
+			actual_360{}
+		};
+
+		const auto bonds = array<const accrual_schedule*, 4>{ &gilt, &other, &gilt, &other };
+		const auto settlements = array<year_month_day, 4>{
+			2023y / August / 31d,
+			2023y / August / 31d,
+			2024y / January / 22d,
+			2024y / January / 14d,
+		};
+
+		auto result = array<double, 4>{};
+		accrued_fractions(bonds, settlements, result);
+
+		EXPECT_EQ(31.0 / 365.0, result[0]);
+		EXPECT_EQ(228.0 / 360.0, result[1]);
+		EXPECT_EQ(-9.0 / 365.0, result[2]);
+		EXPECT_EQ(364.0 / 360.0, result[3]);
+
+		auto small = array<double, 3>{};
+		EXPECT_THROW(accrued_fractions(bonds, settlements, small), out_of_range);
+
+		auto same_bond = array<double, 4>{};
+		accrued_fractions(gilt, settlements, same_bond);
+		EXPECT_EQ(result[0], same_bond[0]);
+		EXPECT_EQ(31.0 / 365.0, same_bond[1]);
+		EXPECT_EQ(result[2], same_bond[2]);
+		EXPECT_EQ(167.0 / 365.0, same_bond[3]);
+	}
+
+}
@@ -0,0 +1,68 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "allocations.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+
+// (the replacements live in their own translation unit, so that they are never inlined next to the library deallocations)
+static auto _allocations = std::atomic<std::size_t>{ 0 };
+
+
+auto operator new(std::size_t size) -> void*
+{
+	++_allocations;
+
+	if (auto p = std::malloc(size == 0 ? 1 : size))
+		return p;
+
+	throw std::bad_alloc{};
+}
+
+
+auto operator delete(void* p) noexcept -> void
+{
+	std::free(p);
+}
+
+
+auto operator delete(void* p, std::size_t) noexcept -> void
+{
+	std::free(p);
+}
+
+
+
+namespace coupon_schedule
+{
+
+	auto allocations() noexcept -> std::size_t
+	{
+		return _allocations.load();
+	}
+
+}
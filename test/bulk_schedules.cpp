@@ -0,0 +1,109 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <bulk_schedules.h>
+#include <quasi_coupon_schedule.h>
+#include <coupon_schedule.h>
+
+#include <schedule.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	inline auto _make_bond_terms() -> vector<bond_terms>
+	{
+		auto result = vector<bond_terms>{};
+		for (auto y = 2000; y < 2020; ++y)
+			for (auto d = 1u; d <= 28u; ++d)
+				result.emplace_back(
+					days_period{ year{ y } / January / 1d, year{ y + 10 } / June / day{ d } },
+					(d % 2u == 0u) ? SemiAnnualy : Quarterly,
+					(d % 3u == 0u) ? quasi_coupon_anchor{ June / day{ d } } : quasi_coupon_anchor{ year{ y } / June / day{ d } }
+				);
+
+		return result;
+	}
+
+
+	TEST(bond_terms, get_frequency)
+	{
+		const auto t = bond_terms{ days_period{ 2020y / January / 1d, 2030y / June / 1d }, Annualy, June / 1d };
+
+		EXPECT_EQ(Annualy, t.get_frequency());
+	}
+
+	TEST(bulk_schedules, make_quasi_coupon_schedules)
+	{
+		const auto terms = _make_bond_terms();
+
+		auto expected = vector<schedule>{};
+		for (const auto& t : terms)
+			expected.push_back(make_quasi_coupon_schedule(t.get_issue_maturity(), t.get_frequency(), t.get_anchor()));
+
+		// output does not depend on the number of threads
+		for (const auto threads : { 1u, 2u, 3u, 8u, 1000u })
+			EXPECT_EQ(expected, make_quasi_coupon_schedules(terms, threads));
+	}
+
+	TEST(bulk_schedules, make_coupon_schedules)
+	{
+		const auto terms = _make_bond_terms();
+
+		auto expected = vector<coupon_periods>{};
+		for (const auto& t : terms)
+			expected.push_back(_make_coupon_schedule(make_quasi_coupon_schedule(t.get_issue_maturity(), t.get_frequency(), t.get_anchor())));
+
+		for (const auto threads : { 1u, 4u })
+			EXPECT_EQ(expected, make_coupon_schedules(terms, threads));
+	}
+
+	TEST(bulk_schedules, empty)
+	{
+		EXPECT_TRUE(make_quasi_coupon_schedules({}, 4u).empty());
+	}
+
+	TEST(bulk_schedules, exception)
+	{
+		auto terms = _make_bond_terms();
+		terms.emplace_back(
+			days_period{ 2023y / January / 1d, 2023y / December / 7d },
+			duration_variant{ months{ 0 } },
+			June / 7d
+		);
+
+		EXPECT_THROW(make_quasi_coupon_schedules(terms, 4u), out_of_range);
+	}
+
+}
@@ -0,0 +1,140 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <business_day_index.h>
+#include <day_counts.h>
+#include <compounding_schedule.h>
+#include <coupon_period.h>
+
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	TEST(business_day_index, is_business_day)
+	{
+		const auto cal = make_calendar_england();
+		const auto index = business_day_index{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		for (auto d = sys_days{ 2018y / January / 1d }; d <= sys_days{ 2025y / December / 31d }; d += days{ 1 })
+			EXPECT_EQ(cal.is_business_day(d), index.is_business_day(d));
+
+		EXPECT_THROW(index.is_business_day(2017y / December / 31d), out_of_range);
+		EXPECT_THROW(index.is_business_day(2026y / January / 1d), out_of_range);
+	}
+
+	TEST(business_day_index, count_business_days)
+	{
+		const auto cal = make_calendar_brazil();
+		const auto index = business_day_index{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		auto gen = mt19937{ 42 };
+		auto offset = uniform_int_distribution<int>{ 0, 365 * 8 - 1 };
+
+		for (auto i = 0; i < 1000; ++i)
+		{
+			auto s = sys_days{ 2018y / January / 1d } + days{ offset(gen) };
+			auto e = sys_days{ 2018y / January / 1d } + days{ offset(gen) };
+			if (e < s)
+				swap(s, e);
+
+			const auto p = days_period{ s, e };
+			EXPECT_EQ(cal.count_business_days(p), index.count_business_days(p));
+		}
+
+		// the whole range, a single day and a block boundary
+		const auto whole = days_period{ 2018y / January / 1d, 2025y / December / 31d };
+		EXPECT_EQ(cal.count_business_days(whole), index.count_business_days(whole));
+		const auto single = days_period{ 2023y / January / 2d, 2023y / January / 2d };
+		EXPECT_EQ(cal.count_business_days(single), index.count_business_days(single));
+		const auto block = days_period{ sys_days{ 2018y / January / 1d } + days{ 63 }, sys_days{ 2018y / January / 1d } + days{ 64 } };
+		EXPECT_EQ(cal.count_business_days(block), index.count_business_days(block));
+
+		EXPECT_THROW(index.count_business_days(days_period{ 2017y / December / 31d, 2018y / January / 2d }), out_of_range);
+	}
+
+	TEST(business_day_index, following_preceding)
+	{
+		const auto cal = make_calendar_england();
+		const auto index = business_day_index{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		// away from the ends of the index, so adjustments do not go outside of it
+		for (auto d = sys_days{ 2018y / January / 8d }; d <= sys_days{ 2025y / December / 20d }; d += days{ 1 })
+		{
+			EXPECT_EQ(Following.adjust(d, cal), index.following(d));
+			EXPECT_EQ(Preceding.adjust(d, cal), index.preceding(d));
+		}
+
+		// 1st of January 2018 is a holiday
+		EXPECT_THROW(index.preceding(2018y / January / 1d), out_of_range);
+		EXPECT_EQ(2018y / January / 2d, index.following(2018y / January / 1d));
+	}
+
+	TEST(business_day_index, calculation_252)
+	{
+		const auto cal = make_calendar_brazil();
+		const auto index = business_day_index{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		const auto dc1 = calculation_252{ &cal };
+		const auto dc2 = calculation_252{ &index };
+
+		const auto p1 = days_period{ 2023y / January / 1d, 2023y / January / 2d };
+		EXPECT_DOUBLE_EQ(1.0 / 252.0, dc2.fraction(p1));
+
+		const auto p2 = days_period{ 2020y / February / 29d, 2024y / February / 29d };
+		EXPECT_EQ(dc1.fraction(p2), dc2.fraction(p2));
+	}
+
+	TEST(business_day_index, make_compounding_schedule)
+	{
+		const auto cal = make_calendar_england();
+		const auto index = business_day_index{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		const auto period = coupon_period{
+			days_period{ 2019y / January / 1d, 2024y / January / 1d },
+			2024y / January / 2d,
+			2024y / January / 1d
+		};
+
+		EXPECT_EQ(make_compounding_schedule(period, cal), make_compounding_schedule(period, index));
+
+		EXPECT_EQ(make_overnight_maturity(2023y / June / 2d, cal), make_overnight_maturity(2023y / June / 2d, index));
+		EXPECT_EQ(make_overnight_effective(2023y / June / 5d, cal), make_overnight_effective(2023y / June / 5d, index));
+	}
+
+}
@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <civil_dates.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	static_assert(to_day_serial(1970y / January / 1d) == 0);
+	static_assert(to_day_serial(2000y / March / 1d) == 11017);
+	static_assert(from_day_serial(-1) == 1969y / December / 31d);
+
+
+	TEST(civil_dates, to_day_serial)
+	{
+		// same as chrono (including before year 0)
+		for (auto d = sys_days{ -1000y / January / 1d }; d <= sys_days{ 3000y / December / 31d }; d += days{ 1 })
+		{
+			const auto ymd = year_month_day{ d };
+
+			EXPECT_EQ(d.time_since_epoch().count(), to_day_serial(ymd));
+			EXPECT_EQ(ymd, from_day_serial(static_cast<day_serial>(d.time_since_epoch().count())));
+		}
+	}
+
+	TEST(civil_dates, to_day_serials)
+	{
+		auto dates = vector<year_month_day>{};
+		for (auto d = sys_days{ 1999y / December / 1d }; d <= sys_days{ 2001y / March / 1d }; d += days{ 1 })
+			dates.emplace_back(d);
+
+		auto serials = vector<day_serial>(dates.size());
+		to_day_serials(dates, serials);
+
+		auto back = vector<year_month_day>(dates.size());
+		from_day_serials(serials, back);
+
+		for (auto i = 0u; i < dates.size(); ++i)
+			EXPECT_EQ(sys_days{ dates[i] }.time_since_epoch().count(), serials[i]);
+		EXPECT_EQ(dates, back);
+
+		EXPECT_THROW(to_day_serials(dates, span{ serials }.first(1)), out_of_range);
+		EXPECT_THROW(from_day_serials(serials, span{ back }.first(1)), out_of_range);
+	}
+
+}
@@ -0,0 +1,117 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <compact_coupon_period.h>
+#include <coupon_period.h>
+
+#include <period.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	TEST(compact_coupon_period, constructor1)
+	{
+		const auto p = compact_coupon_period{
+			sys_days{ 2023y / January / 1d },
+			sys_days{ 2023y / June / 7d },
+			sys_days{ 2023y / June / 8d },
+			sys_days{ 2023y / June / 1d }
+		};
+
+		EXPECT_EQ(sys_days{ 2023y / January / 1d }, p.get_accrual_start_date());
+		EXPECT_EQ(sys_days{ 2023y / June / 7d }, p.get_accrual_end_date());
+		EXPECT_EQ(sys_days{ 2023y / June / 8d }, p.get_pay_date());
+		EXPECT_EQ(sys_days{ 2023y / June / 1d }, p.get_ex_div_date());
+	}
+
+	TEST(compact_coupon_period, constructor2)
+	{
+		const auto cp = coupon_period{
+			days_period{ 2023y / January / 1d, 2023y / June / 7d },
+			2023y / June / 8d,
+			2023y / June / 1d
+		};
+
+		const auto p = compact_coupon_period{ cp };
+
+		EXPECT_EQ(sys_days{ 2023y / January / 1d }, p.get_accrual_start_date());
+		EXPECT_EQ(sys_days{ 2023y / June / 7d }, p.get_accrual_end_date());
+		EXPECT_EQ(sys_days{ 2023y / June / 8d }, p.get_pay_date());
+		EXPECT_EQ(sys_days{ 2023y / June / 1d }, p.get_ex_div_date());
+	}
+
+	TEST(compact_coupon_period, constructor3)
+	{
+		// days past the end of the month roll over into the next one
+		const auto cp = coupon_period{
+			days_period{ 2023y / January / 1d, 2023y / June / 7d },
+			2023y / February / 30d, // not a valid date
+			2023y / June / 1d
+		};
+
+		EXPECT_EQ(sys_days{ 2023y / March / 2d }, compact_coupon_period{ cp }.get_pay_date());
+
+		const auto bad_month = coupon_period{
+			days_period{ 2023y / January / 1d, 2023y / June / 7d },
+			2023y / month{ 13 } / 1d,
+			2023y / June / 1d
+		};
+
+		EXPECT_THROW(compact_coupon_period{ bad_month }, std::out_of_range);
+	}
+
+	TEST(compact_coupon_period, to_coupon_period)
+	{
+		const auto cp = coupon_period{
+			days_period{ 2023y / January / 1d, 2023y / June / 7d },
+			2023y / June / 8d,
+			2023y / June / 1d
+		};
+
+		EXPECT_EQ(cp, compact_coupon_period{ cp }.to_coupon_period());
+	}
+
+	TEST(compact_coupon_period, make_compact_coupon_periods)
+	{
+		const auto cps = coupon_periods{
+			{ days_period{ 2023y / January / 1d, 2023y / June / 7d }, 2023y / June / 7d },
+			{ days_period{ 2023y / June / 7d, 2023y / December / 7d }, 2023y / December / 7d },
+		};
+
+		const auto compact = make_compact_coupon_periods(cps);
+
+		EXPECT_EQ(2u, compact.size());
+		EXPECT_EQ(cps, make_coupon_periods(compact));
+	}
+
+}
@@ -0,0 +1,107 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <compact_frequency.h>
+#include <quasi_coupon_schedule.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	TEST(compact_frequency, constructor)
+	{
+		EXPECT_EQ((compact_frequency{ frequency_unit::days, 1 }), compact_frequency{ Daily });
+		EXPECT_EQ((compact_frequency{ frequency_unit::days, 7, true }), compact_frequency{ Weekly });
+		EXPECT_EQ((compact_frequency{ frequency_unit::months, 1 }), compact_frequency{ Monthly });
+		EXPECT_EQ((compact_frequency{ frequency_unit::months, 6 }), compact_frequency{ SemiAnnualy });
+		EXPECT_EQ((compact_frequency{ frequency_unit::months, 12, true }), compact_frequency{ Annualy });
+		EXPECT_EQ((compact_frequency{ frequency_unit::months, -24, true }), compact_frequency{ duration_variant{ -years{ 2 } } });
+
+		// the same steps, but not the same frequency (as for duration_variant)
+		EXPECT_NE(compact_frequency{ duration_variant{ days{ 7 } } }, compact_frequency{ Weekly });
+
+		EXPECT_THROW(compact_frequency{ duration_variant{ days{ 1ll << 32 } } }, out_of_range);
+	}
+
+	TEST(compact_frequency, to_duration_variant)
+	{
+		// the round trip keeps the units
+		for (const auto& dv : { Annualy, SemiAnnualy, Quarterly, Monthly, Weekly, Daily, duration_variant{ -years{ 2 } }, duration_variant{ days{ 14 } } })
+			EXPECT_EQ(dv, compact_frequency{ dv }.to_duration_variant());
+
+		EXPECT_EQ(duration_variant{ -weeks{ 1 } }, negate(compact_frequency{ Weekly }).to_duration_variant());
+
+		// a count, which is not a whole number of weeks (years)
+		EXPECT_EQ(duration_variant{ days{ 8 } }, (compact_frequency{ frequency_unit::days, 8, true }.to_duration_variant()));
+		EXPECT_EQ(duration_variant{ months{ 18 } }, (compact_frequency{ frequency_unit::months, 18, true }.to_duration_variant()));
+	}
+
+	TEST(compact_frequency, is_forward_backward)
+	{
+		EXPECT_TRUE(is_forward(compact_frequency{ Quarterly }));
+		EXPECT_FALSE(is_backward(compact_frequency{ Quarterly }));
+		EXPECT_TRUE(is_backward(negate(compact_frequency{ Quarterly })));
+		EXPECT_FALSE(is_forward(compact_frequency{}));
+		EXPECT_FALSE(is_backward(compact_frequency{}));
+	}
+
+	TEST(compact_frequency, advance_n)
+	{
+		// same as the full variant
+		const auto check = [](const duration_variant& dv)
+		{
+			const auto f = compact_frequency{ dv };
+
+			for (auto d = sys_days{ 2023y / January / 1d }; d <= sys_days{ 2024y / December / 31d }; d += days{ 11 })
+			{
+				const auto ymd = year_month_day{ d };
+
+				EXPECT_EQ(advance_n(ymd, dv, 5), _advance_n(ymd, f, 5));
+				EXPECT_EQ(advance_n(ymd, dv, -3), _advance_n(ymd, f, -3));
+				EXPECT_EQ(steps_between(2023y / June / 7d, ymd, dv), _steps_between(2023y / June / 7d, ymd, f));
+			}
+		};
+
+		check(Annualy);
+		check(SemiAnnualy);
+		check(Quarterly);
+		check(Monthly);
+		check(Weekly);
+		check(Daily);
+		check(duration_variant{ -months{ 6 } });
+		check(duration_variant{ -weeks{ 2 } });
+
+		EXPECT_THROW(_steps_between(2023y / June / 7d, 2023y / June / 7d, compact_frequency{}), out_of_range);
+	}
+
+}
@@ -0,0 +1,207 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+#include "allocations.h"
+
+#include <compounded_rate.h>
+#include <observation_conventions.h>
+#include <compounding_schedule.h>
+#include <coupon_period.h>
+#include <day_counts.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	TEST(compounded_rate, make_compounding_weights)
+	{
+		const auto cps = compounding_periods{
+			{ days_period{ 2023y / June / 1d, 2023y / June / 2d }, 2023y / June / 1d },
+			{ days_period{ 2023y / June / 2d, 2023y / June / 5d }, 2023y / June / 2d },
+		};
+
+		const auto w = make_compounding_weights(cps, Actual365Fixed);
+
+		EXPECT_EQ(sys_days{ 2023y / June / 1d }, w.get_resets()[0]);
+		EXPECT_EQ(sys_days{ 2023y / June / 2d }, w.get_resets()[1]);
+		EXPECT_DOUBLE_EQ(1.0 / 365.0, w.get_accrual_factors()[0]);
+		EXPECT_DOUBLE_EQ(3.0 / 365.0, w.get_accrual_factors()[1]);
+		EXPECT_DOUBLE_EQ(4.0 / 365.0, w.get_year_fraction());
+	}
+
+	TEST(compounded_rate, compound1)
+	{
+		const auto period = coupon_period{
+			days_period{ 2023y / June / 1d, 2023y / June / 8d },
+			2023y / June / 8d,
+			2023y / June / 8d
+		};
+
+		const auto cal = make_calendar_england();
+
+		const auto w = make_compounding_weights(make_compounding_schedule(period, cal), Actual365Fixed);
+
+		// one fixing per calendar day from the 1st of June (weekend values are never used)
+		const auto rates = vector<double>{ 0.04, 0.05, -1.0, -1.0, 0.06, 0.07, 0.08 };
+		const auto f = overnight_fixings{ sys_days{ 2023y / June / 1d }, rates };
+
+		const auto r = compound(w, f);
+
+		const auto expected_product =
+			(1.0 + 0.04 * 1.0 / 365.0) *
+			(1.0 + 0.05 * 3.0 / 365.0) *
+			(1.0 + 0.06 * 1.0 / 365.0) *
+			(1.0 + 0.07 * 1.0 / 365.0) *
+			(1.0 + 0.08 * 1.0 / 365.0);
+
+		EXPECT_DOUBLE_EQ((expected_product - 1.0) * 365.0 / 7.0, r.get_rate());
+		EXPECT_DOUBLE_EQ(7.0 / 365.0, r.get_year_fraction());
+		EXPECT_EQ(5u, r.get_accrual_factors().size());
+	}
+
+	TEST(compounded_rate, compound2)
+	{
+		// flat fixings over a single day is just that fixing
+		const auto cps = compounding_periods{
+			{ days_period{ 2023y / June / 1d, 2023y / June / 2d }, 2023y / June / 1d },
+		};
+
+		const auto w = make_compounding_weights(cps, Actual360);
+
+		const auto rates = vector<double>{ 0.05 };
+		const auto f = overnight_fixings{ sys_days{ 2023y / June / 1d }, rates };
+
+		EXPECT_NEAR(0.05, compound(w, f).get_rate(), 1e-12);
+	}
+
+	TEST(compounded_rate, compound3)
+	{
+		// fixings do not cover the resets
+		const auto cps = compounding_periods{
+			{ days_period{ 2023y / June / 1d, 2023y / June / 2d }, 2023y / June / 1d },
+			{ days_period{ 2023y / June / 2d, 2023y / June / 5d }, 2023y / June / 2d },
+		};
+
+		const auto w = make_compounding_weights(cps, Actual360);
+
+		const auto rates = vector<double>{ 0.05 };
+
+		EXPECT_THROW(compound(w, overnight_fixings{ sys_days{ 2023y / June / 1d }, rates }), out_of_range);
+		EXPECT_THROW(compound(w, overnight_fixings{ sys_days{ 2023y / June / 2d }, rates }), out_of_range);
+	}
+
+	TEST(compounded_rate, compound4)
+	{
+		// the rate keeps the accrual factors alive (so it can outlive the weights it was computed from)
+		const auto cps = compounding_periods{
+			{ days_period{ 2023y / June / 1d, 2023y / June / 2d }, 2023y / June / 1d },
+			{ days_period{ 2023y / June / 2d, 2023y / June / 5d }, 2023y / June / 2d },
+		};
+
+		const auto rates = vector<double>{ 0.05, 0.05 };
+
+		const auto r = compound(make_compounding_weights(cps, Actual365Fixed), overnight_fixings{ sys_days{ 2023y / June / 1d }, rates });
+
+		ASSERT_EQ(2u, r.get_accrual_factors().size());
+		EXPECT_DOUBLE_EQ(1.0 / 365.0, r.get_accrual_factors()[0]);
+		EXPECT_DOUBLE_EQ(3.0 / 365.0, r.get_accrual_factors()[1]);
+	}
+
+	TEST(compounding_index, compound)
+	{
+		const auto cal = make_calendar_england();
+
+		const auto period = coupon_period{
+			days_period{ 2023y / June / 1d, 2023y / June / 8d },
+			2023y / June / 8d,
+			2023y / June / 8d
+		};
+
+		const auto w = lookback{ 2 }.make_weights(make_compounding_schedule(period, cal), cal, Actual365Fixed);
+
+		const auto index = compounding_index{ w, sys_days{ 2023y / May / 30d } };
+
+		const auto expected_offsets = vector<int32_t>{ 0, 1, 2, 3, 6 };
+		EXPECT_EQ(expected_offsets, vector<int32_t>(index.get_offsets().begin(), index.get_offsets().end()));
+
+		// many sets of fixings for the same index
+		for (const auto level : { 0.01, 0.02, 0.05 })
+		{
+			const auto rates = vector<double>(7, level);
+
+			const auto r1 = compound(index, rates);
+			const auto r2 = compound(w, overnight_fixings{ sys_days{ 2023y / May / 30d }, rates });
+
+			EXPECT_EQ(r2.get_rate(), r1.get_rate());
+			EXPECT_GT(r1.get_rate(), level); // compounding
+		}
+
+		EXPECT_THROW(compound(index, vector<double>(6, 0.01)), out_of_range);
+		EXPECT_THROW((compounding_index{ w, sys_days{ 2023y / May / 31d } }), out_of_range);
+	}
+
+	TEST(compounding_index, compound_allocations)
+	{
+		// revaluing is just a gather and a product (the rates share the accrual factors of the index)
+		const auto cal = make_calendar_england();
+
+		const auto period = coupon_period{
+			days_period{ 2023y / June / 1d, 2023y / June / 8d },
+			2023y / June / 8d,
+			2023y / June / 8d
+		};
+
+		const auto w = lookback{ 2 }.make_weights(make_compounding_schedule(period, cal), cal, Actual365Fixed);
+		const auto index = compounding_index{ w, sys_days{ 2023y / May / 30d } };
+
+		const auto rates = vector<double>(7, 0.05);
+
+		const auto before = allocations();
+
+		auto shared = true;
+		for (auto i = 0; i < 1000; ++i)
+		{
+			const auto r = compound(index, rates);
+			shared = shared && r.get_accrual_factors().data() == index.get_accrual_factors().data();
+		}
+
+		const auto after = allocations();
+
+		EXPECT_EQ(before, after);
+		EXPECT_TRUE(shared);
+		EXPECT_EQ(w.get_accrual_factors().data(), index.get_accrual_factors().data());
+	}
+
+}
@@ -31,6 +31,10 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <ranges>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
 
 using namespace gregorian;
 
@@ -173,4 +177,98 @@ namespace coupon_schedule
 		EXPECT_EQ(expected, compounding_schedule);
 	}
 
+	TEST(compounding_schedule, make_compounding_schedule6)
+	{
+		// a long coupon period (one compounding period per business day)
+		const auto period = coupon_period{
+			days_period{ 2019y / January / 1d, 2024y / January / 1d },
+			2024y / January / 2d,
+			2024y / January / 1d
+		};
+
+		const auto cal = make_calendar_england();
+
+		const auto compounding_schedule = make_compounding_schedule(period, cal);
+
+		// 1st of January is a holiday, so the first period starts on a non-business day
+		auto business_days = 0u;
+		for (auto d = sys_days{ 2019y / January / 2d }; d < sys_days{ 2024y / January / 1d }; d += days{ 1 })
+			if (cal.is_business_day(d))
+				++business_days;
+
+		EXPECT_EQ(1u + business_days, compounding_schedule.size());
+
+		EXPECT_EQ(2019y / January / 1d, compounding_schedule.front()._period.get_from());
+		EXPECT_EQ(2024y / January / 1d, compounding_schedule.back()._period.get_until());
+
+		for (auto i = 1u; i < compounding_schedule.size(); ++i)
+			EXPECT_EQ(compounding_schedule[i - 1]._period.get_until(), compounding_schedule[i]._period.get_from());
+
+		for (const auto& p : compounding_schedule)
+			EXPECT_EQ(Preceding.adjust(p._period.get_from(), cal), p._reset);
+	}
+
+	TEST(compounding_schedule, make_compounding_schedule7)
+	{
+		// all memory comes from the arena
+		const auto period = coupon_period{
+			days_period{ 2019y / January / 1d, 2024y / January / 1d },
+			2024y / January / 2d,
+			2024y / January / 1d
+		};
+
+		const auto cal = make_calendar_england();
+
+		auto buffer = std::array<std::byte, 1 << 16>{};
+		auto arena = std::pmr::monotonic_buffer_resource{ buffer.data(), buffer.size(), std::pmr::null_memory_resource() };
+
+		const auto compounding_schedule = make_compounding_schedule(period, cal, &arena);
+
+		EXPECT_EQ(&arena, compounding_schedule.get_allocator().resource());
+		EXPECT_TRUE(std::ranges::equal(make_compounding_schedule(period, cal), compounding_schedule));
+	}
+
+	static_assert(std::ranges::view<compounding_schedule_view>);
+	static_assert(std::ranges::forward_range<compounding_schedule_view>);
+
+	TEST(compounding_schedule, compounding_schedule_view1)
+	{
+		const auto cal = make_calendar_england();
+
+		const auto periods = {
+			coupon_period{ days_period{ 2023y / June / 1d, 2023y / June / 8d }, 2023y / June / 8d, 2023y / June / 8d }, // standard
+			coupon_period{ days_period{ 2023y / June / 3d, 2023y / June / 8d }, 2023y / June / 8d, 2023y / June / 8d }, // non-standard first period
+			coupon_period{ days_period{ 2023y / June / 1d, 2023y / June / 4d }, 2023y / June / 8d, 2023y / June / 4d }, // non-standard last period
+			coupon_period{ days_period{ 2023y / June / 3d, 2023y / June / 4d }, 2023y / June / 8d, 2023y / June / 4d }, // both
+			coupon_period{ days_period{ 2023y / June / 1d, 2023y / June / 1d }, 2023y / June / 8d, 2023y / June / 1d }, // empty
+			coupon_period{ days_period{ 2019y / January / 1d, 2024y / January / 1d }, 2024y / January / 2d, 2024y / January / 1d }, // long
+		};
+
+		for (const auto& period : periods)
+		{
+			const auto view = compounding_schedule_view{ period, cal };
+
+			EXPECT_EQ(make_compounding_schedule(period, cal), view | std::ranges::to<compounding_periods>());
+		}
+	}
+
+	TEST(compounding_schedule, compounding_schedule_view2)
+	{
+		// fold over the periods without materialising them
+		const auto period = coupon_period{
+			days_period{ 2023y / June / 1d, 2023y / June / 8d },
+			2023y / June / 8d,
+			2023y / June / 8d
+		};
+
+		const auto cal = make_calendar_england();
+
+		auto days_compounded = 0;
+		for (const auto& p : compounding_schedule_view{ period, cal })
+			days_compounded += (sys_days{ p._period.get_until() } - sys_days{ p._period.get_from() }).count();
+
+		EXPECT_EQ(7, days_compounded);
+		EXPECT_EQ(5, std::ranges::distance(compounding_schedule_view{ period, cal }));
+	}
+
 }
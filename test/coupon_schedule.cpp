@@ -24,6 +24,7 @@
 
 #include <coupon_period.h>
 #include <coupon_schedule.h>
+#include <compact_coupon_period.h>
 #include <quasi_coupon_schedule.h>
 
 #include <calendar.h>
@@ -31,9 +32,15 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <algorithm>
+#include <memory_resource>
 
 using namespace gregorian;
 
+using namespace std;
 using namespace std::chrono;
 
 
@@ -61,4 +68,161 @@ namespace coupon_schedule
 		EXPECT_EQ(expected, gilt_coupon_schedule);
 	}
 */
+
+	TEST(coupon_schedule, make_coupon_schedule_1)
+	{
+		const auto expected = coupon_periods{
+			{ { 2023y / January / 1d, 2023y / June / 7d }, 2023y / June / 7d },
+			{ { 2023y / June / 7d, 2023y / December / 7d }, 2023y / December / 7d },
+		};
+
+		const auto i_m = days_period{ 2023y / January / 1d, 2023y / December / 7d };
+
+		const auto qcs = make_quasi_coupon_schedule(i_m, SemiAnnualy, June / 7d);
+
+		// from a set
+		EXPECT_EQ(expected, make_coupon_schedule(i_m, qcs.get_dates()));
+
+		// from a vector
+		const auto dates = vector<year_month_day>{ qcs.get_dates().cbegin(), qcs.get_dates().cend() };
+		EXPECT_EQ(expected, make_coupon_schedule(i_m, dates));
+
+		// from a lazy view
+		const auto view = experimental::_make_quasi_coupon_schedule_forward(i_m, compact_frequency{ SemiAnnualy }, 2022y / December / 7d);
+		EXPECT_EQ(expected, make_coupon_schedule(i_m, view));
+	}
+
+	TEST(coupon_schedule, make_coupon_schedule_2)
+	{
+		// pay dates adjusted for holidays
+		const auto expected = coupon_periods{
+			{ { 2024y / January / 1d, 2024y / March / 30d }, 2024y / April / 2d, 2024y / March / 30d },
+			{ { 2024y / March / 30d, 2024y / September / 30d }, 2024y / September / 30d, 2024y / September / 30d },
+		};
+
+		const auto cal = make_calendar_england();
+
+		const auto i_m = days_period{ 2024y / January / 1d, 2024y / September / 30d };
+		const auto qcs = make_quasi_coupon_schedule(i_m, SemiAnnualy, March / 30d);
+
+		EXPECT_EQ(expected, make_coupon_schedule(i_m, qcs.get_dates(), cal));
+
+		const auto view = experimental::_make_quasi_coupon_schedule_forward(i_m, compact_frequency{ SemiAnnualy }, 2023y / September / 30d);
+		EXPECT_EQ(expected, make_coupon_schedule(i_m, view, cal));
+	}
+
+	TEST(coupon_schedule, make_coupon_schedule_3)
+	{
+		// "from" and "until" on the quasi coupon dates
+		const auto expected = coupon_periods{
+			{ { 2022y / December / 7d, 2023y / June / 7d }, 2023y / June / 7d },
+			{ { 2023y / June / 7d, 2023y / December / 7d }, 2023y / December / 7d },
+		};
+
+		const auto qcs = make_quasi_coupon_schedule(
+			days_period{ 2023y / January / 1d, 2023y / December / 7d },
+			SemiAnnualy,
+			June / 7d
+		);
+
+		EXPECT_EQ(expected, _make_coupon_schedule(qcs));
+	}
+
+	TEST(coupon_schedule, make_coupon_schedule_4)
+	{
+		const auto expected = coupon_periods{
+			{ { 2023y / June / 7d, 2023y / June / 7d }, 2023y / June / 7d },
+		};
+
+		const auto i_m = days_period{ 2023y / June / 7d, 2023y / June / 7d };
+
+		EXPECT_EQ(expected, make_coupon_schedule(i_m, vector<year_month_day>{ 2023y / June / 7d }));
+		EXPECT_EQ(expected, make_coupon_schedule(i_m, vector<year_month_day>{}));
+	}
+
+	TEST(coupon_schedule, make_coupon_schedule_5)
+	{
+		// all memory comes from the arena
+		const auto cal = make_calendar_england();
+
+		const auto i_m = days_period{ 2024y / January / 1d, 2024y / September / 30d };
+		const auto qcs = make_quasi_coupon_schedule(i_m, SemiAnnualy, March / 30d);
+
+		auto buffer = array<byte, 1024>{};
+		auto arena = std::pmr::monotonic_buffer_resource{ buffer.data(), buffer.size(), std::pmr::null_memory_resource() };
+
+		const auto s1 = make_coupon_schedule(i_m, qcs.get_dates(), &arena);
+		EXPECT_EQ(&arena, s1.get_allocator().resource());
+		EXPECT_TRUE(ranges::equal(make_coupon_schedule(i_m, qcs.get_dates()), s1));
+
+		const auto s2 = make_coupon_schedule(i_m, qcs.get_dates(), cal, &Following, &arena);
+		EXPECT_EQ(&arena, s2.get_allocator().resource());
+		EXPECT_TRUE(ranges::equal(make_coupon_schedule(i_m, qcs.get_dates(), cal), s2));
+
+		const auto s3 = _make_coupon_schedule(qcs, &arena);
+		EXPECT_EQ(&arena, s3.get_allocator().resource());
+		EXPECT_TRUE(ranges::equal(_make_coupon_schedule(qcs), s3));
+	}
+
+	TEST(coupon_schedule, make_compact_coupon_schedule)
+	{
+		const auto expected = compact_coupon_periods{
+			{ sys_days{ 2023y / January / 1d }, sys_days{ 2023y / June / 7d }, sys_days{ 2023y / June / 7d }, sys_days{ 2023y / June / 7d } },
+			{ sys_days{ 2023y / June / 7d }, sys_days{ 2023y / December / 7d }, sys_days{ 2023y / December / 7d }, sys_days{ 2023y / December / 7d } },
+		};
+
+		const auto qcs = schedule{
+			days_period{ 2023y / January / 1d, 2023y / December / 7d },
+			schedule::dates{
+				2023y / June / 7d,
+				2023y / December / 7d,
+			}
+		};
+
+		const auto compact_coupon_schedule = _make_compact_coupon_schedule(qcs);
+
+		EXPECT_EQ(expected, compact_coupon_schedule);
+
+		// the same accrual periods as the full coupon schedule
+		const auto coupon_schedule = _make_coupon_schedule(qcs);
+		ASSERT_EQ(coupon_schedule.size(), compact_coupon_schedule.size());
+		for (auto i = 0u; i < coupon_schedule.size(); ++i)
+		{
+			EXPECT_EQ(sys_days{ coupon_schedule[i].get_accrual_start_date() }, compact_coupon_schedule[i].get_accrual_start_date());
+			EXPECT_EQ(sys_days{ coupon_schedule[i].get_accrual_end_date() }, compact_coupon_schedule[i].get_accrual_end_date());
+		}
+	}
+
+	TEST(coupon_schedule, make_compact_coupon_schedule_end_of_month)
+	{
+		// anchored on the 31st, so some of the quasi coupon dates overflow their months (e.g. February 31)
+		const auto qcs = make_quasi_coupon_schedule(
+			days_period{ 2023y / January / 31d, 2023y / June / 30d },
+			Monthly,
+			2023y / January / 31d
+		);
+		ASSERT_TRUE(qcs.get_dates().contains(2023y / February / 31d));
+
+		const auto compact_coupon_schedule = _make_compact_coupon_schedule(qcs);
+
+		// both ways of building compact periods agree (and roll February 31 over to March 3)
+		EXPECT_EQ(make_compact_coupon_periods(_make_coupon_schedule(qcs)), compact_coupon_schedule);
+		EXPECT_EQ(sys_days{ 2023y / March / 3d }, compact_coupon_schedule[0].get_accrual_end_date());
+		EXPECT_EQ(sys_days{ 2023y / March / 3d }, compact_coupon_schedule[1].get_accrual_start_date());
+	}
+
+	TEST(coupon_schedule, make_compact_coupon_schedule_empty)
+	{
+		const auto expected = compact_coupon_periods{
+			{ sys_days{ 2023y / June / 7d }, sys_days{ 2023y / June / 7d }, sys_days{ 2023y / June / 7d }, sys_days{ 2023y / June / 7d } },
+		};
+
+		const auto qcs = schedule{
+			days_period{ 2023y / June / 7d, 2023y / June / 7d },
+			schedule::dates{ 2023y / June / 7d }
+		};
+
+		EXPECT_EQ(expected, _make_compact_coupon_schedule(qcs));
+	}
+
 }
@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <coupon_schedule_columns.h>
+#include <coupon_period.h>
+#include <coupon_schedule.h>
+#include <quasi_coupon_schedule.h>
+#include <day_counts.h>
+#include <day_count_variant.h>
+
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <ranges>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	static_assert(ranges::random_access_range<decltype(declval<const coupon_schedule_columns&>().periods())>);
+
+	TEST(coupon_schedule_columns, constructor)
+	{
+		const auto cps = coupon_periods{
+			{ { 2023y / January / 1d, 2023y / June / 7d }, 2023y / June / 8d, 2023y / May / 30d },
+			{ { 2023y / June / 7d, 2023y / December / 7d }, 2023y / December / 8d, 2023y / November / 29d },
+		};
+
+		const auto columns = coupon_schedule_columns{ cps };
+
+		EXPECT_EQ(2u, columns.size());
+		EXPECT_FALSE(columns.empty());
+
+		EXPECT_EQ(2023y / January / 1d, columns.get_accrual_start_dates()[0]);
+		EXPECT_EQ(2023y / June / 7d, columns.get_accrual_start_dates()[1]);
+		EXPECT_EQ(2023y / June / 7d, columns.get_accrual_end_dates()[0]);
+		EXPECT_EQ(2023y / December / 7d, columns.get_accrual_end_dates()[1]);
+		EXPECT_EQ(2023y / June / 8d, columns.get_pay_dates()[0]);
+		EXPECT_EQ(2023y / December / 8d, columns.get_pay_dates()[1]);
+		EXPECT_EQ(2023y / May / 30d, columns.get_ex_div_dates()[0]);
+		EXPECT_EQ(2023y / November / 29d, columns.get_ex_div_dates()[1]);
+
+		EXPECT_EQ(cps, columns.to_coupon_periods());
+
+		EXPECT_TRUE(coupon_schedule_columns{}.empty());
+	}
+
+	TEST(coupon_schedule_columns, periods)
+	{
+		const auto cps = coupon_periods{
+			{ { 2023y / January / 1d, 2023y / June / 7d }, 2023y / June / 8d, 2023y / May / 30d },
+			{ { 2023y / June / 7d, 2023y / December / 7d }, 2023y / December / 8d, 2023y / November / 29d },
+		};
+
+		const auto columns = coupon_schedule_columns{ cps };
+
+		auto i = 0u;
+		for (const auto& r : columns.periods())
+		{
+			EXPECT_EQ(cps[i].get_period(), r.get_period());
+			EXPECT_EQ(cps[i].get_accrual_start_date(), r.get_accrual_start_date());
+			EXPECT_EQ(cps[i].get_accrual_end_date(), r.get_accrual_end_date());
+			EXPECT_EQ(cps[i].get_pay_date(), r.get_pay_date());
+			EXPECT_EQ(cps[i].get_ex_div_date(), r.get_ex_div_date());
+			EXPECT_EQ(cps[i], r.to_coupon_period());
+			++i;
+		}
+		EXPECT_EQ(cps.size(), i);
+
+		EXPECT_EQ(columns[1], columns.periods()[1]);
+		EXPECT_FALSE(columns[0] == columns[1]);
+	}
+
+	TEST(coupon_schedule_columns, make_coupon_schedule_columns)
+	{
+		const auto cal = make_calendar_england();
+
+		const auto i_m = days_period{ 2020y / January / 1d, 2024y / September / 30d };
+		const auto qcs = make_quasi_coupon_schedule(i_m, SemiAnnualy, March / 30d);
+
+		EXPECT_EQ(
+			coupon_schedule_columns{ make_coupon_schedule(i_m, qcs.get_dates()) },
+			make_coupon_schedule_columns(i_m, qcs.get_dates())
+		);
+		EXPECT_EQ(
+			coupon_schedule_columns{ make_coupon_schedule(i_m, qcs.get_dates(), cal) },
+			make_coupon_schedule_columns(i_m, qcs.get_dates(), cal)
+		);
+	}
+
+	TEST(coupon_schedule_columns, fractions)
+	{
+		// columns go straight into the batch day count
+		const auto i_m = days_period{ 2020y / January / 1d, 2024y / September / 30d };
+		const auto qcs = make_quasi_coupon_schedule(i_m, SemiAnnualy, March / 30d);
+
+		const auto cps = make_coupon_schedule(i_m, qcs.get_dates());
+		const auto columns = make_coupon_schedule_columns(i_m, qcs.get_dates());
+
+		const auto dc = day_count_variant{ actual_actual{} };
+
+		auto result = vector<double>(columns.size());
+		fractions(dc, columns.get_accrual_start_dates(), columns.get_accrual_end_dates(), result);
+
+		for (auto i = 0u; i < cps.size(); ++i)
+			EXPECT_EQ(fraction(dc, cps[i].get_period()), result[i]);
+	}
+
+}
@@ -72,6 +72,22 @@ namespace coupon_schedule
 	}
 
 
+	TEST(not_after_quasi_coupon_date, adjust_distant_anchor)
+	{
+		// anchor is a century before the "date"
+		EXPECT_EQ(
+			2022y / December / 7d,
+			NotAfter.adjust(2023y / January / 1d, months{ 6 }, 1922y / June / 7d)
+		);
+
+		// anchor is a century after the "date"
+		EXPECT_EQ(
+			2022y / December / 7d,
+			NotAfter.adjust(2022y / December / 1d, months{ -6 }, 2122y / June / 7d)
+		);
+	}
+
+
 	TEST(not_before_quasi_coupon_date, adjust)
 	{
 		// anchor is on the "date" ("date" is on the quasi date strip)
@@ -108,4 +124,20 @@ namespace coupon_schedule
 		);
 	}
 
+
+	TEST(not_before_quasi_coupon_date, adjust_distant_anchor)
+	{
+		// anchor is a century after the "date"
+		EXPECT_EQ(
+			2022y / December / 7d,
+			NotBefore.adjust(2023y / June / 1d, months{ 6 }, 2123y / June / 7d)
+		);
+
+		// anchor is a century before the "date"
+		EXPECT_EQ(
+			2022y / December / 7d,
+			NotBefore.adjust(2022y / December / 1d, months{ -6 }, 1922y / June / 7d)
+		);
+	}
+
 }
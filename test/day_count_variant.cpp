@@ -0,0 +1,136 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <day_count_variant.h>
+#include <day_counts.h>
+
+#include <period.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+
+using namespace gregorian;
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	class actual_364_fixed final : public day_count
+	{
+
+	private:
+
+		auto _fraction(const days_period& period) const -> double final
+		{
+			return _actual(period) / 364.0;
+		}
+
+	};
+
+
+	TEST(day_count_variant, fraction)
+	{
+		const auto p = days_period{ 2023y / January / 31d, 2024y / March / 31d };
+
+		const auto cal = make_calendar_brazil();
+		const auto a364 = actual_364_fixed{};
+
+		const auto dcs = vector<day_count_variant>{
+			One1,
+			ActualActual,
+			Actual365Fixed,
+			Actual360,
+			Thirty360,
+			ThirtyE360,
+			thirty_e_360_isda{ 2024y / March / 31d },
+			Actual365L,
+			calculation_252{ &cal },
+			&a364,
+		};
+
+		for (const auto& dcv : dcs)
+		{
+			EXPECT_EQ(get_day_count(dcv).fraction(p), fraction(dcv, p));
+			EXPECT_EQ(get_day_count(dcv).fraction(p), fraction(dcv, p.get_from(), p.get_until()));
+		}
+
+		EXPECT_DOUBLE_EQ(425.0 / 364.0, fraction(dcs.back(), p));
+	}
+
+	TEST(day_count_variant, fractions)
+	{
+		const auto periods = vector<days_period>{
+			{ 2023y / January / 1d, 2023y / January / 2d },
+			{ 2023y / June / 7d, 2023y / December / 7d },
+			{ 2023y / December / 7d, 2024y / June / 7d },
+		};
+		const auto starts = vector<year_month_day>{ 2023y / January / 1d, 2023y / June / 7d, 2023y / December / 7d };
+		const auto ends = vector<year_month_day>{ 2023y / January / 2d, 2023y / December / 7d, 2024y / June / 7d };
+
+		const auto a364 = actual_364_fixed{};
+
+		for (const auto& dcv : { day_count_variant{ ActualActual }, day_count_variant{ &a364 } })
+		{
+			auto result1 = vector<double>(periods.size());
+			fractions(dcv, periods, result1);
+
+			auto result2 = vector<double>(periods.size());
+			fractions(dcv, starts, ends, result2);
+
+			for (auto i = 0u; i < periods.size(); ++i)
+			{
+				EXPECT_EQ(get_day_count(dcv).fraction(periods[i]), result1[i]);
+				EXPECT_EQ(get_day_count(dcv).fraction(periods[i]), result2[i]);
+			}
+		}
+
+		auto result = vector<double>(1);
+		EXPECT_THROW(fractions(day_count_variant{ Actual360 }, periods, result), out_of_range);
+
+		// a reversed pair
+		auto result3 = vector<double>(periods.size());
+		EXPECT_THROW(fractions(day_count_variant{ Actual360 }, ends, starts, result3), out_of_range);
+		EXPECT_THROW(fractions(day_count_variant{ &a364 }, ends, starts, result3), out_of_range);
+	}
+
+	TEST(day_count_variant, value_semantics)
+	{
+		// day counts can now be held by value (for example in instrument records)
+		auto dcv = day_count_variant{ thirty_e_360_isda{ 2023y / February / 28d } };
+		const auto copy = dcv;
+
+		dcv = Actual360;
+
+		const auto p = days_period{ 2023y / January / 1d, 2023y / January / 2d };
+		EXPECT_DOUBLE_EQ(1.0 / 360.0, fraction(dcv, p));
+		EXPECT_TRUE(holds_alternative<thirty_e_360_isda>(copy));
+	}
+
+}
@@ -29,6 +29,8 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <vector>
+#include <stdexcept>
 
 using namespace gregorian;
 using namespace std;
@@ -52,6 +54,34 @@ namespace coupon_schedule
 		EXPECT_DOUBLE_EQ(1.0 / 365.0, ActualActual.fraction(p));
 	}
 
+	TEST(actual_actual, fraction_table)
+	{
+		// the gregorian calendar repeats every 400 years, so the same period 400 years later (outside of the table) should give exactly the same fraction
+		auto periods = vector<days_period>{};
+		auto shifted = vector<days_period>{};
+		for (auto d = sys_days{ 1950y / January / 1d }; d <= sys_days{ 2099y / December / 31d }; d += days{ 37 })
+		{
+			const auto start = year_month_day{ d };
+			const auto end = year_month_day{ d + days{ 1 + (d.time_since_epoch().count() % 1500 + 1500) % 1500 } };
+
+			periods.emplace_back(start, end);
+			shifted.emplace_back(start + years{ 400 }, end + years{ 400 });
+		}
+
+		auto result = vector<double>(periods.size());
+		ActualActual.fractions(periods, result);
+
+		for (auto i = 0u; i < periods.size(); ++i)
+		{
+			EXPECT_EQ(ActualActual.fraction(shifted[i]), ActualActual.fraction(periods[i]));
+			EXPECT_EQ(ActualActual.fraction(shifted[i]), result[i]);
+		}
+
+		// across the edges of the table
+		EXPECT_DOUBLE_EQ(1.0, ActualActual.fraction(days_period{ 1899y / December / 31d, 1900y / December / 31d }));
+		EXPECT_DOUBLE_EQ(1.0, ActualActual.fraction(days_period{ 2299y / June / 1d, 2300y / June / 1d }));
+	}
+
 	TEST(actual_365_fixed, fraction)
 	{
 		const auto p = period{ 2023y / January / 1d, 2023y / January / 2d };
@@ -89,6 +119,16 @@ namespace coupon_schedule
 		EXPECT_DOUBLE_EQ(1.0 / 360.0, dc.fraction(p));
 	}
 
+	TEST(thirty_360, month_difference)
+	{
+		const auto p = days_period{ 2023y / January / 15d, 2023y / March / 15d };
+
+		EXPECT_DOUBLE_EQ(60.0 / 360.0, Thirty360.fraction(p));
+		EXPECT_DOUBLE_EQ(60.0 / 360.0, ThirtyE360.fraction(p));
+		EXPECT_DOUBLE_EQ(60.0 / 360.0, thirty_e_360_isda{ 2023y / March / 15d }.fraction(p));
+		EXPECT_DOUBLE_EQ(0.5, Thirty360.fraction(days_period{ 2023y / June / 30d, 2023y / December / 31d }));
+	}
+
 	TEST(actual_365_l, fraction)
 	{
 		const auto p1 = period{ 2023y / January / 1d, 2023y / January / 2d };
@@ -108,4 +148,132 @@ namespace coupon_schedule
 		EXPECT_DOUBLE_EQ(1.0 / 252.0, dc.fraction(p));
 	}
 
+	TEST(day_count_base, fraction)
+	{
+		const auto start = 2023y / January / 1d;
+		const auto end = 2023y / July / 1d;
+
+		EXPECT_EQ(Actual365Fixed.fraction(days_period{ start, end }), Actual365Fixed.fraction(start, end));
+		EXPECT_EQ(Thirty360.fraction(days_period{ start, end }), Thirty360.fraction(start, end));
+		EXPECT_EQ(0.0, Actual360.fraction(start, start));
+
+		// the same as for days_period
+		EXPECT_THROW(Actual365Fixed.fraction(end, start), out_of_range);
+		EXPECT_THROW(Thirty360.fraction(end, start), out_of_range);
+	}
+
+
+	inline auto _make_periods() -> vector<days_period>
+	{
+		return vector<days_period>{
+			{ 2023y / January / 1d, 2023y / January / 2d },
+			{ 2023y / January / 31d, 2023y / March / 31d },
+			{ 2023y / June / 7d, 2023y / December / 7d },
+			{ 2023y / December / 7d, 2024y / June / 7d },
+			{ 2020y / February / 29d, 2024y / February / 29d },
+		};
+	}
+
+	inline auto _expect_fractions(const day_count& dc)
+	{
+		const auto periods = _make_periods();
+
+		auto starts = vector<year_month_day>{};
+		auto ends = vector<year_month_day>{};
+		for (const auto& p : periods)
+		{
+			starts.push_back(p.get_from());
+			ends.push_back(p.get_until());
+		}
+
+		auto result1 = vector<double>(periods.size());
+		dc.fractions(periods, result1);
+
+		auto result2 = vector<double>(periods.size());
+		dc.fractions(starts, ends, result2);
+
+		for (auto i = 0u; i < periods.size(); ++i)
+		{
+			EXPECT_EQ(dc.fraction(periods[i]), result1[i]);
+			EXPECT_EQ(dc.fraction(periods[i]), result2[i]);
+		}
+	}
+
+	TEST(day_count, fractions)
+	{
+		_expect_fractions(One1);
+		_expect_fractions(ActualActual);
+		_expect_fractions(Actual365Fixed);
+		_expect_fractions(Actual360);
+		_expect_fractions(Thirty360);
+		_expect_fractions(ThirtyE360);
+		_expect_fractions(thirty_e_360_isda{ 2024y / February / 29d });
+		_expect_fractions(Actual365L);
+
+		const auto cal = make_calendar_brazil();
+		_expect_fractions(calculation_252{ &cal });
+	}
+
+	TEST(day_count, fractions_blocks)
+	{
+		// more than one block of serials (and a partial one at the end)
+		auto periods = vector<days_period>{};
+		for (auto i = 0; i < 1000; ++i)
+		{
+			const auto start = sys_days{ 1999y / December / 1d } + days{ i * 17 };
+			periods.emplace_back(year_month_day{ start }, year_month_day{ start + days{ 1 + i % 800 } });
+		}
+
+		for (const auto* dc : vector<const day_count*>{ &Actual365Fixed, &Actual360, &Actual365L })
+		{
+			auto result = vector<double>(periods.size());
+			dc->fractions(periods, result);
+
+			for (auto i = 0u; i < periods.size(); ++i)
+				EXPECT_EQ(dc->fraction(periods[i]), result[i]);
+		}
+	}
+
+	class actual_364 final : public day_count
+	{
+
+	private:
+
+		auto _fraction(const days_period& period) const -> double final
+		{
+			return _actual(period) / 364.0;
+		}
+
+	};
+
+	TEST(day_count, fractions_user_defined)
+	{
+		_expect_fractions(actual_364{});
+	}
+
+	TEST(day_count, fractions_size_mismatch)
+	{
+		const auto periods = _make_periods();
+		auto result = vector<double>(periods.size() - 1);
+
+		EXPECT_THROW(Actual360.fractions(periods, result), out_of_range);
+	}
+
+	TEST(day_count, fractions_order)
+	{
+		// the same as for days_period (the second pair is reversed)
+		const auto starts = vector<year_month_day>{ 2023y / January / 1d, 2023y / June / 7d };
+		const auto ends = vector<year_month_day>{ 2023y / January / 2d, 2023y / January / 7d };
+		auto result = vector<double>(starts.size());
+
+		const auto cal = make_calendar_brazil();
+		const auto c252 = calculation_252{ &cal };
+		const auto a364 = actual_364{};
+
+		for (const auto* dc : vector<const day_count*>{ &One1, &ActualActual, &Actual360, &Thirty360, &c252, &a364 })
+			EXPECT_THROW(dc->fractions(starts, ends, result), out_of_range);
+
+		EXPECT_THROW(thirty_e_360_isda_fractions(starts, ends, starts, result), out_of_range);
+	}
+
 }
@@ -27,6 +27,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <stdexcept>
 
 using namespace std::chrono;
 
@@ -50,6 +51,64 @@ namespace coupon_schedule
 		EXPECT_EQ(2023y / January / 1d, retreat(2024y / January / 1d, years{ 1 }));
 	}
 
+	TEST(duration_variant, advance_n)
+	{
+		EXPECT_EQ(2024y / January / 11d, advance_n(2024y / January / 1d, days{ 1 }, 10));
+		EXPECT_EQ(2024y / March / 11d, advance_n(2024y / January / 1d, weeks{ 1 }, 10));
+		EXPECT_EQ(2024y / November / 1d, advance_n(2024y / January / 1d, months{ 1 }, 10));
+		EXPECT_EQ(2034y / January / 1d, advance_n(2024y / January / 1d, years{ 1 }, 10));
+
+		EXPECT_EQ(2023y / December / 22d, advance_n(2024y / January / 1d, days{ 1 }, -10));
+		EXPECT_EQ(2014y / January / 1d, advance_n(2024y / January / 1d, years{ -1 }, 10));
+		EXPECT_EQ(2024y / January / 1d, advance_n(2024y / January / 1d, months{ 6 }, 0));
+
+		// the same as advancing one step at a time (including through the shorter months)
+		EXPECT_EQ(2024y / March / 31d, advance_n(2024y / January / 31d, months{ 1 }, 2));
+		EXPECT_EQ(advance(advance(2024y / January / 31d, months{ 1 }), months{ 1 }), advance_n(2024y / January / 31d, months{ 1 }, 2));
+	}
+
+	TEST(duration_variant, advance_n_month_index)
+	{
+		// months and years are done on the month index, which should be the same as chrono's own arithmetic
+		for (auto d = sys_days{ 2023y / January / 1d }; d <= sys_days{ 2024y / December / 31d }; d += days{ 3 })
+		{
+			const auto ymd = year_month_day{ d };
+
+			for (auto n = -40; n <= 40; n += 7)
+			{
+				EXPECT_EQ(ymd + months{ n }, advance_n(ymd, months{ 1 }, n));
+				EXPECT_EQ(ymd + months{ 3 * n }, advance_n(ymd, months{ 3 }, n));
+				EXPECT_EQ(ymd + years{ n }, advance_n(ymd, years{ 1 }, n));
+			}
+		}
+
+		// before year 0
+		EXPECT_EQ(-1y / December / 15d, advance_n(0y / January / 15d, months{ 1 }, -1));
+	}
+
+	TEST(duration_variant, steps_between)
+	{
+		EXPECT_EQ(10, steps_between(2024y / January / 1d, 2024y / January / 11d, days{ 1 }));
+		EXPECT_EQ(1, steps_between(2024y / January / 1d, 2024y / January / 14d, weeks{ 1 }));
+		EXPECT_EQ(1, steps_between(2024y / January / 1d, 2024y / February / 29d, months{ 1 }));
+		EXPECT_EQ(2, steps_between(2024y / January / 1d, 2024y / March / 1d, months{ 1 }));
+		EXPECT_EQ(0, steps_between(2024y / January / 1d, 2024y / December / 31d, years{ 1 }));
+
+		// "to" is behind "from"
+		EXPECT_EQ(-1, steps_between(2024y / January / 1d, 2023y / December / 31d, days{ 1 }));
+		EXPECT_EQ(-2, steps_between(2024y / January / 7d, 2023y / June / 1d, months{ 6 }));
+
+		// backward frequency
+		EXPECT_EQ(1, steps_between(2023y / June / 7d, 2022y / December / 1d, months{ -6 }));
+		EXPECT_EQ(-1, steps_between(2022y / June / 7d, 2022y / December / 1d, months{ -6 }));
+
+		// perpetual-like distance
+		EXPECT_EQ(200, steps_between(1923y / June / 7d, 2023y / June / 7d, months{ 6 }));
+		EXPECT_EQ(199, steps_between(1923y / June / 7d, 2023y / June / 6d, months{ 6 }));
+
+		EXPECT_THROW(steps_between(2024y / January / 1d, 2024y / March / 1d, months{ 0 }), std::out_of_range);
+	}
+
 	TEST(duration_variant, is_forward)
 	{
 		EXPECT_TRUE(is_forward(days{ 1 }));
@@ -0,0 +1,115 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <fixed_frequency.h>
+#include <quasi_coupon_schedule.h>
+
+#include <schedule.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <array>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	// generated by the compiler
+	constexpr auto Dates = make_quasi_coupon_dates<3u>(2023y / January / 1d, 2023y / December / 7d, semi_annualy{}, 2023y / June / 7d);
+
+	static_assert(Dates[0] == 2022y / December / 7d);
+	static_assert(Dates[1] == 2023y / June / 7d);
+	static_assert(Dates[2] == 2023y / December / 7d);
+
+	static_assert(quasi_coupon_dates_count(2023y / January / 31d, 2023y / December / 31d, monthly{}, 2000y / January / 31d) == 12u);
+	static_assert(advance(2023y / June / 7d, annualy{}) == 2024y / June / 7d);
+	static_assert(steps_between(2023y / January / 1d, 2023y / March / 31d, weekly{}) == 12);
+
+
+	TEST(fixed_frequency, operator_duration_variant)
+	{
+		EXPECT_EQ(SemiAnnualy, duration_variant{ semi_annualy{} });
+		EXPECT_EQ(Quarterly, duration_variant{ quarterly{} });
+		EXPECT_EQ(duration_variant{ days{ 1 } }, duration_variant{ daily{} });
+	}
+
+	TEST(fixed_frequency, advance)
+	{
+		// same as the runtime frequencies
+		const auto check = [](auto f)
+		{
+			for (auto d = sys_days{ 2023y / January / 1d }; d <= sys_days{ 2024y / December / 31d }; d += days{ 13 })
+			{
+				const auto ymd = year_month_day{ d };
+
+				EXPECT_EQ(advance(ymd, duration_variant{ f }), advance(ymd, f));
+				EXPECT_EQ(retreat(ymd, duration_variant{ f }), retreat(ymd, f));
+				EXPECT_EQ(advance_n(ymd, duration_variant{ f }, 7), advance_n(ymd, f, 7));
+				EXPECT_EQ(steps_between(2023y / June / 7d, ymd, duration_variant{ f }), steps_between(2023y / June / 7d, ymd, f));
+			}
+		};
+
+		check(annualy{});
+		check(semi_annualy{});
+		check(quarterly{});
+		check(monthly{});
+		check(weekly{});
+		check(daily{});
+	}
+
+	TEST(fixed_frequency, make_quasi_coupon_dates)
+	{
+		EXPECT_THROW(
+			(make_quasi_coupon_dates<2u>(2023y / January / 1d, 2023y / December / 7d, semi_annualy{}, 2023y / June / 7d)),
+			out_of_range
+		);
+	}
+
+	TEST(fixed_frequency, make_quasi_coupon_schedule)
+	{
+		// same as the runtime frequencies
+		const auto check = [](const days_period& i_m, auto f, const year_month_day& a)
+		{
+			const auto expected = make_quasi_coupon_schedule(i_m, duration_variant{ f }, a);
+
+			EXPECT_EQ(expected, make_quasi_coupon_schedule(i_m, f, a));
+			EXPECT_EQ(expected.get_dates().size(), quasi_coupon_dates_count(i_m.get_from(), i_m.get_until(), f, a));
+		};
+
+		check(days_period{ 2023y / January / 1d, 2023y / December / 7d }, semi_annualy{}, 2023y / June / 7d);
+		check(days_period{ 2023y / September / 20d, 2023y / December / 20d }, quarterly{}, 2023y / June / 20d);
+		check(days_period{ 2023y / June / 20d, 2023y / December / 20d }, quarterly{}, 2023y / September / 20d);
+		check(days_period{ 2020y / March / 15d, 2050y / March / 15d }, monthly{}, 2000y / January / 31d);
+		check(days_period{ 2023y / January / 1d, 2024y / January / 1d }, weekly{}, 2023y / January / 2d);
+		check(days_period{ 2019y / February / 28d, 2029y / February / 28d }, annualy{}, 2020y / February / 29d);
+	}
+
+}
@@ -0,0 +1,129 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <flat_schedule.h>
+#include <quasi_coupon_schedule.h>
+
+#include <schedule.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <array>
+#include <vector>
+#include <optional>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	TEST(flat_schedule, constructor)
+	{
+		EXPECT_THROW(
+			(flat_schedule{
+				days_period{ 2023y / January / 1d, 2023y / December / 31d },
+				flat_schedule::dates{ 2023y / June / 7d, 2023y / June / 7d }
+			}),
+			out_of_range
+		);
+		EXPECT_THROW(
+			(flat_schedule{
+				days_period{ 2023y / January / 1d, 2023y / December / 31d },
+				flat_schedule::dates{ 2023y / December / 7d, 2023y / June / 7d }
+			}),
+			out_of_range
+		);
+	}
+
+	TEST(flat_schedule, find)
+	{
+		const auto s = flat_schedule{
+			days_period{ 2022y / December / 7d, 2023y / December / 7d },
+			flat_schedule::dates{
+				2022y / December / 7d,
+				2023y / June / 7d,
+				2023y / December / 7d,
+			}
+		};
+
+		EXPECT_TRUE(s.contains(2023y / June / 7d));
+		EXPECT_FALSE(s.contains(2023y / June / 8d));
+
+		EXPECT_EQ(nullopt, s.find_not_after(2022y / December / 6d));
+		EXPECT_EQ(2022y / December / 7d, s.find_not_after(2022y / December / 7d));
+		EXPECT_EQ(2022y / December / 7d, s.find_not_after(2023y / June / 6d));
+		EXPECT_EQ(2023y / December / 7d, s.find_not_after(2024y / January / 1d));
+
+		EXPECT_EQ(2022y / December / 7d, s.find_not_before(2022y / January / 1d));
+		EXPECT_EQ(2023y / June / 7d, s.find_not_before(2022y / December / 8d));
+		EXPECT_EQ(2023y / June / 7d, s.find_not_before(2023y / June / 7d));
+		EXPECT_EQ(nullopt, s.find_not_before(2023y / December / 8d));
+	}
+
+	TEST(flat_schedule, make_flat_quasi_coupon_schedule)
+	{
+		// same as the set based schedules, for all anchors and frequencies
+		const auto check = [](const days_period& i_m, const duration_variant& f, const quasi_coupon_anchor& a)
+		{
+			const auto expected = make_quasi_coupon_schedule(i_m, f, a);
+			const auto flat = make_flat_quasi_coupon_schedule(i_m, f, a);
+
+			EXPECT_EQ(expected, flat.to_schedule());
+		};
+
+		check(days_period{ 2023y / January / 1d, 2023y / December / 7d }, SemiAnnualy, June / 7d);
+		check(days_period{ 2023y / September / 20d, 2023y / December / 20d }, Quarterly, June / 20d);
+		check(days_period{ 2023y / June / 20d, 2023y / December / 20d }, Quarterly, September / 20d);
+		check(days_period{ 2023y / January / 1d, 2023y / December / 7d }, duration_variant{ -months{ 6 } }, June / 7d);
+		check(days_period{ 2000y / January / 3d, 2040y / March / 15d }, Quarterly, 1900y / March / 15d);
+		check(days_period{ 2023y / January / 2d, 2024y / January / 1d }, Weekly, 2023y / January / 2d);
+	}
+
+	TEST(flat_schedule, make_quasi_coupon_dates)
+	{
+		const auto i_m = days_period{ 2023y / January / 1d, 2023y / December / 7d };
+
+		auto buffer = array<year_month_day, 4>{};
+		const auto ds = make_quasi_coupon_dates(i_m, SemiAnnualy, 2023y / June / 7d, buffer);
+
+		const auto expected = vector<year_month_day>{
+			2022y / December / 7d,
+			2023y / June / 7d,
+			2023y / December / 7d,
+		};
+		EXPECT_EQ(expected, vector<year_month_day>(ds.begin(), ds.end()));
+		EXPECT_EQ(buffer.data(), ds.data());
+
+		auto small = array<year_month_day, 2>{};
+		EXPECT_THROW(make_quasi_coupon_dates(i_m, SemiAnnualy, 2023y / June / 7d, small), out_of_range);
+	}
+
+}
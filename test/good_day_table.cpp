@@ -0,0 +1,177 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <good_day_table.h>
+#include <business_day_index.h>
+#include <compounding_schedule.h>
+#include <coupon_schedule.h>
+#include <coupon_period.h>
+#include <quasi_coupon_schedule.h>
+
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	TEST(good_day_table, following_preceding)
+	{
+		const auto cal = make_calendar_england();
+		const auto table = good_day_table{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		// away from the ends of the table, so adjustments do not go outside of it
+		for (auto d = sys_days{ 2018y / January / 8d }; d <= sys_days{ 2025y / December / 20d }; d += days{ 1 })
+		{
+			EXPECT_EQ(Following.adjust(d, cal), table.following(d));
+			EXPECT_EQ(Preceding.adjust(d, cal), table.preceding(d));
+		}
+
+		// 1st of January 2018 is a holiday
+		EXPECT_THROW(table.preceding(2018y / January / 1d), out_of_range);
+		EXPECT_EQ(2018y / January / 2d, table.following(2018y / January / 1d));
+
+		EXPECT_THROW(table.following(2026y / January / 1d), out_of_range);
+		EXPECT_THROW(table.preceding(2017y / December / 31d), out_of_range);
+	}
+
+	TEST(good_day_table, modified_following_preceding)
+	{
+		const auto cal = make_calendar_england();
+		const auto table = good_day_table{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		// Saturday at the end of the month
+		EXPECT_EQ(2023y / September / 29d, table.modified_following(2023y / September / 30d));
+		EXPECT_EQ(2023y / September / 29d, table.modified_preceding(2023y / September / 30d));
+
+		// Sunday at the start of the month
+		EXPECT_EQ(2023y / October / 2d, table.modified_following(2023y / October / 1d));
+		EXPECT_EQ(2023y / October / 2d, table.modified_preceding(2023y / October / 1d));
+
+		// Saturday in the middle of the month
+		EXPECT_EQ(2023y / October / 16d, table.modified_following(2023y / October / 14d));
+		EXPECT_EQ(2023y / October / 13d, table.modified_preceding(2023y / October / 14d));
+	}
+
+	TEST(good_day_table, business_day_index)
+	{
+		const auto cal = make_calendar_england();
+		const auto index = business_day_index{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+		const auto table = good_day_table{ index };
+
+		EXPECT_EQ(index.get_from_until(), table.get_from_until());
+
+		for (auto d = sys_days{ 2018y / January / 8d }; d <= sys_days{ 2025y / December / 20d }; d += days{ 1 })
+		{
+			EXPECT_EQ(index.following(d), table.following(d));
+			EXPECT_EQ(index.preceding(d), table.preceding(d));
+		}
+	}
+
+	TEST(good_day_table, adjust)
+	{
+		const auto cal = make_calendar_england();
+		const auto table = good_day_table{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		// Saturday at the end of the month
+		const auto d = 2023y / September / 30d;
+
+		EXPECT_EQ(d, table.adjust(d, &NoAdjustment));
+		EXPECT_EQ(table.following(d), table.adjust(d, &Following));
+		EXPECT_EQ(table.modified_following(d), table.adjust(d, &ModifiedFollowing));
+		EXPECT_EQ(table.preceding(d), table.adjust(d, &Preceding));
+		EXPECT_EQ(table.modified_preceding(d), table.adjust(d, &ModifiedPreceding));
+
+		// a copy of a convention works as well
+		const auto f = following{};
+		EXPECT_EQ(table.following(d), table.adjust(d, &f));
+	}
+
+	TEST(good_day_table, batch)
+	{
+		const auto cal = make_calendar_england();
+		const auto table = good_day_table{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		auto dates = vector<year_month_day>{};
+		for (auto d = sys_days{ 2023y / December / 20d }; d <= sys_days{ 2024y / January / 10d }; d += days{ 1 })
+			dates.push_back(d);
+
+		auto result = vector<year_month_day>(dates.size());
+
+		table.following(dates, result);
+		for (auto i = 0u; i < dates.size(); ++i)
+			EXPECT_EQ(Following.adjust(dates[i], cal), result[i]);
+
+		table.preceding(dates, result);
+		for (auto i = 0u; i < dates.size(); ++i)
+			EXPECT_EQ(Preceding.adjust(dates[i], cal), result[i]);
+
+		auto small = vector<year_month_day>(dates.size() - 1u);
+		EXPECT_THROW(table.following(dates, small), out_of_range);
+	}
+
+	TEST(good_day_table, make_compounding_schedule)
+	{
+		const auto cal = make_calendar_england();
+		const auto table = good_day_table{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		const auto period = coupon_period{
+			days_period{ 2019y / January / 1d, 2024y / January / 1d },
+			2024y / January / 2d,
+			2024y / January / 1d
+		};
+
+		EXPECT_EQ(make_compounding_schedule(period, cal), make_compounding_schedule(period, table));
+
+		EXPECT_EQ(make_overnight_maturity(2023y / June / 2d, cal), make_overnight_maturity(2023y / June / 2d, table));
+		EXPECT_EQ(make_overnight_effective(2023y / June / 5d, cal), make_overnight_effective(2023y / June / 5d, table));
+	}
+
+	TEST(good_day_table, make_coupon_schedule)
+	{
+		const auto cal = make_calendar_england();
+		const auto table = good_day_table{ cal, days_period{ 2018y / January / 1d, 2025y / December / 31d } };
+
+		const auto i_m = days_period{ 2019y / January / 1d, 2024y / September / 30d };
+		const auto qcs = make_quasi_coupon_schedule(i_m, Quarterly, March / 30d);
+
+		EXPECT_EQ(make_coupon_schedule(i_m, qcs.get_dates(), cal), make_coupon_schedule(i_m, qcs.get_dates(), table));
+
+		for (const auto* bdc : vector<const business_day_convention*>{ &Following, &Preceding, &ModifiedFollowing })
+			EXPECT_EQ(make_coupon_schedule(i_m, qcs.get_dates(), cal, bdc), make_coupon_schedule(i_m, qcs.get_dates(), table, bdc));
+	}
+
+}
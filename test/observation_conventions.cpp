@@ -0,0 +1,146 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <observation_conventions.h>
+#include <compounded_rate.h>
+#include <compounding_schedule.h>
+#include <coupon_period.h>
+#include <day_counts.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	inline auto _make_compounding_schedule_june() -> compounding_periods
+	{
+		const auto period = coupon_period{
+			days_period{ 2023y / June / 1d, 2023y / June / 8d },
+			2023y / June / 8d,
+			2023y / June / 8d
+		};
+
+		return make_compounding_schedule(period, make_calendar_england());
+	}
+
+	inline auto _resets(const compounding_weights& w) -> vector<sys_days>
+	{
+		return vector<sys_days>{ w.get_resets().begin(), w.get_resets().end() };
+	}
+
+	inline auto _accrual_factors(const compounding_weights& w) -> vector<double>
+	{
+		return vector<double>{ w.get_accrual_factors().begin(), w.get_accrual_factors().end() };
+	}
+
+
+	TEST(in_arrears, make_weights)
+	{
+		const auto cal = make_calendar_england();
+		const auto w = InArrears.make_weights(_make_compounding_schedule_june(), cal, Actual365Fixed);
+
+		const auto expected = vector<sys_days>{
+			2023y / June / 1d,
+			2023y / June / 2d,
+			2023y / June / 5d,
+			2023y / June / 6d,
+			2023y / June / 7d,
+		};
+
+		EXPECT_EQ(expected, _resets(w));
+		EXPECT_DOUBLE_EQ(7.0 / 365.0, w.get_year_fraction());
+	}
+
+	TEST(lookback, make_weights)
+	{
+		const auto cal = make_calendar_england();
+		const auto w = lookback{ 2 }.make_weights(_make_compounding_schedule_june(), cal, Actual365Fixed);
+
+		// 29th of May is a bank holiday
+		const auto expected = vector<sys_days>{
+			2023y / May / 30d,
+			2023y / May / 31d,
+			2023y / June / 1d,
+			2023y / June / 2d,
+			2023y / June / 5d,
+		};
+
+		EXPECT_EQ(expected, _resets(w));
+		EXPECT_DOUBLE_EQ(7.0 / 365.0, w.get_year_fraction());
+
+		EXPECT_EQ(_resets(InArrears.make_weights(_make_compounding_schedule_june(), cal, Actual365Fixed)), _resets(lookback{ 0 }.make_weights(_make_compounding_schedule_june(), cal, Actual365Fixed)));
+	}
+
+	TEST(lockout, make_weights)
+	{
+		const auto cal = make_calendar_england();
+		const auto w = lockout{ 2 }.make_weights(_make_compounding_schedule_june(), cal, Actual365Fixed);
+
+		const auto expected = vector<sys_days>{
+			2023y / June / 1d,
+			2023y / June / 2d,
+			2023y / June / 5d,
+			2023y / June / 5d,
+			2023y / June / 5d,
+		};
+
+		EXPECT_EQ(expected, _resets(w));
+		EXPECT_DOUBLE_EQ(7.0 / 365.0, w.get_year_fraction());
+
+		// we can not lock more than all but the first period
+		const auto w2 = lockout{ 10 }.make_weights(_make_compounding_schedule_june(), cal, Actual365Fixed);
+		EXPECT_EQ(vector<sys_days>(5, sys_days{ 2023y / June / 1d }), _resets(w2));
+	}
+
+	TEST(observation_shift, make_weights)
+	{
+		const auto cal = make_calendar_england();
+		const auto w = observation_shift{ 2 }.make_weights(_make_compounding_schedule_june(), cal, Actual365Fixed);
+
+		const auto expected_resets = vector<sys_days>{
+			2023y / May / 30d,
+			2023y / May / 31d,
+			2023y / June / 1d,
+			2023y / June / 2d,
+			2023y / June / 5d,
+		};
+
+		const auto expected_accrual_factors = vector<double>{ 1.0 / 365.0, 1.0 / 365.0, 1.0 / 365.0, 3.0 / 365.0, 1.0 / 365.0 }; // from the observation period
+
+		EXPECT_EQ(expected_resets, _resets(w));
+		EXPECT_EQ(expected_accrual_factors, _accrual_factors(w));
+		EXPECT_DOUBLE_EQ(7.0 / 365.0, w.get_year_fraction());
+	}
+
+}
@@ -28,6 +28,12 @@
 
 #include <chrono>
 #include <stdexcept>
+#include <ranges>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
 
 using namespace gregorian;
 
@@ -191,4 +197,149 @@ namespace coupon_schedule
 		EXPECT_THROW(make_quasi_coupon_schedule(i_m, f, a), out_of_range);
 	}
 
+	TEST(quasi_coupon_schedule, make_quasi_coupon_schedule_9)
+	{
+		// anchor is long before the "from" (like a perpetual)
+		const auto expected = schedule{
+			days_period{ 2022y / December / 7d, 2023y / December / 7d },
+			schedule::dates{
+				2022y / December / 7d,
+				2023y / June / 7d,
+				2023y / December / 7d,
+			}
+		};
+
+		const auto quasi_coupon_schedule = make_quasi_coupon_schedule(
+			days_period{ 2023y / January / 1d, 2023y / December / 7d },
+			SemiAnnualy,
+			1853y / June / 7d
+		);
+
+		EXPECT_EQ(expected, quasi_coupon_schedule);
+	}
+
+	TEST(quasi_coupon_schedule, make_quasi_coupon_schedule_10)
+	{
+		// anchor is long after the "from"
+		const auto expected = schedule{
+			days_period{ 2022y / December / 7d, 2023y / December / 7d },
+			schedule::dates{
+				2022y / December / 7d,
+				2023y / June / 7d,
+				2023y / December / 7d,
+			}
+		};
+
+		const auto quasi_coupon_schedule = make_quasi_coupon_schedule(
+			days_period{ 2023y / January / 1d, 2023y / December / 7d },
+			SemiAnnualy,
+			2193y / June / 7d
+		);
+
+		EXPECT_EQ(expected, quasi_coupon_schedule);
+	}
+
+	TEST(quasi_coupon_schedule, make_quasi_coupon_schedule_11)
+	{
+		// monthly family against stepping one date at a time with chrono (including the 31st, which is not valid in every month)
+		const auto i_m = days_period{ 1995y / March / 1d, 2045y / February / 27d };
+
+		const auto check = [&i_m](const months& f, const year_month_day& first)
+		{
+			auto d0 = first;
+			while (d0 + f <= i_m.get_from())
+				d0 += f;
+
+			auto expected = schedule::dates{};
+			for (auto d = d0; ; d += f)
+			{
+				expected.insert(d);
+				if (d >= i_m.get_until())
+					break;
+			}
+
+			EXPECT_EQ(expected, make_quasi_coupon_schedule(i_m, f, first).get_dates());
+			EXPECT_EQ(expected, experimental::make_quasi_coupon_schedule(i_m, f, first).get_dates());
+			EXPECT_EQ(expected, experimental::make_quasi_coupon_schedule(i_m, -f, year_month_day{ *expected.crbegin() }).get_dates());
+		};
+
+		check(months{ 1 }, 1995y / January / 31d);
+		check(months{ 3 }, 1995y / February / 15d);
+		check(months{ 6 }, 1994y / December / 31d);
+		check(months{ 12 }, 1995y / February / 28d);
+	}
+
+	static_assert(std::ranges::view<experimental::quasi_coupon_schedule_view>);
+	static_assert(std::ranges::random_access_range<experimental::quasi_coupon_schedule_view>);
+	static_assert(std::ranges::sized_range<experimental::quasi_coupon_schedule_view>);
+	static_assert(std::ranges::common_range<experimental::quasi_coupon_schedule_view>);
+
+	TEST(quasi_coupon_schedule, quasi_coupon_schedule_view_1)
+	{
+		const auto view = experimental::make_quasi_coupon_schedule_view(
+			days_period{ 2023y / January / 1d, 2023y / December / 7d },
+			SemiAnnualy,
+			2023y / June / 7d
+		);
+
+		EXPECT_EQ(3u, view.size());
+		EXPECT_EQ(2022y / December / 7d, view[0]);
+		EXPECT_EQ(2023y / June / 7d, view[1]);
+		EXPECT_EQ(2023y / December / 7d, view[2]);
+		EXPECT_EQ(2023y / December / 7d, view.back());
+
+		// algorithms work on it directly
+		EXPECT_TRUE(ranges::binary_search(view, 2023y / June / 7d));
+		EXPECT_FALSE(ranges::binary_search(view, 2023y / June / 8d));
+		EXPECT_EQ(2023y / June / 7d, *ranges::lower_bound(view, 2023y / January / 1d));
+
+		const auto reversed = view | views::reverse | ranges::to<vector<year_month_day>>();
+		const auto expected = vector<year_month_day>{ 2023y / December / 7d, 2023y / June / 7d, 2022y / December / 7d };
+		EXPECT_EQ(expected, reversed);
+
+		auto i = view.begin();
+		i += 2;
+		EXPECT_EQ(2023y / December / 7d, *i);
+		EXPECT_EQ(2, i - view.begin());
+		EXPECT_EQ(2022y / December / 7d, *--(--i));
+		EXPECT_TRUE(view.begin() < view.end());
+	}
+
+	TEST(quasi_coupon_schedule, quasi_coupon_schedule_view_2)
+	{
+		// backward frequencies come out in ascending order too
+		const auto i_m = days_period{ 2023y / January / 1d, 2023y / December / 7d };
+		const auto f = duration_variant{ -months{ 6 } };
+
+		const auto view = experimental::make_quasi_coupon_schedule_view(i_m, f, 2023y / June / 7d);
+
+		EXPECT_TRUE(ranges::is_sorted(view));
+		EXPECT_EQ(
+			experimental::make_quasi_coupon_schedule(i_m, f, 2023y / June / 7d).get_dates(),
+			view | ranges::to<schedule::dates>()
+		);
+
+		EXPECT_THROW(experimental::make_quasi_coupon_schedule_view(i_m, duration_variant{ days{ 0 } }, 2023y / June / 7d), out_of_range);
+	}
+
+	TEST(quasi_coupon_schedule, make_quasi_coupon_schedule_pmr)
+	{
+		// all memory comes from the arena
+		auto buffer = array<byte, 4096>{};
+		auto arena = std::pmr::monotonic_buffer_resource{ buffer.data(), buffer.size(), std::pmr::null_memory_resource() };
+
+		const auto check = [&](const days_period& i_m, const duration_variant& f, const quasi_coupon_anchor& a)
+		{
+			const auto expected = make_quasi_coupon_schedule(i_m, f, a);
+			const auto dates = make_quasi_coupon_schedule(i_m, f, a, &arena);
+
+			EXPECT_EQ(&arena, dates.get_allocator().resource());
+			EXPECT_TRUE(ranges::equal(expected.get_dates(), dates));
+		};
+
+		check(days_period{ 2023y / January / 1d, 2023y / December / 7d }, SemiAnnualy, June / 7d);
+		check(days_period{ 2023y / January / 1d, 2023y / December / 7d }, duration_variant{ -months{ 6 } }, June / 7d);
+		check(days_period{ 2000y / January / 3d, 2040y / March / 15d }, Quarterly, 1900y / March / 15d);
+	}
+
 }
@@ -0,0 +1,141 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <quasi_coupon_schedule_cache.h>
+#include <quasi_coupon_schedule.h>
+
+#include <schedule.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	TEST(quasi_coupon_schedule_cache, get)
+	{
+		auto cache = quasi_coupon_schedule_cache{ 100 };
+
+		const auto i_m = days_period{ 2023y / January / 1d, 2023y / December / 7d };
+
+		const auto s1 = cache.get(i_m, SemiAnnualy, June / 7d);
+		const auto s2 = cache.get(i_m, SemiAnnualy, June / 7d);
+
+		EXPECT_EQ(make_quasi_coupon_schedule(i_m, SemiAnnualy, June / 7d), *s1);
+		EXPECT_EQ(s1, s2); // the same shared schedule
+
+		EXPECT_EQ(1u, cache.get_hits());
+		EXPECT_EQ(1u, cache.get_misses());
+		EXPECT_EQ(1u, cache.size());
+	}
+
+	TEST(quasi_coupon_schedule_cache, get_different_keys)
+	{
+		auto cache = quasi_coupon_schedule_cache{ 100 };
+
+		const auto i_m = days_period{ 2023y / January / 1d, 2023y / December / 7d };
+
+		// the same dates as an anchor, but different overloads of make_quasi_coupon_schedule
+		const auto s1 = cache.get(i_m, SemiAnnualy, June / 7d);
+		const auto s2 = cache.get(i_m, SemiAnnualy, 2023y / June / 7d);
+		const auto s3 = cache.get(i_m, Quarterly, June / 7d);
+
+		EXPECT_NE(s1, s2);
+		EXPECT_NE(s1, s3);
+		EXPECT_EQ(make_quasi_coupon_schedule(i_m, SemiAnnualy, 2023y / June / 7d), *s2);
+		EXPECT_EQ(make_quasi_coupon_schedule(i_m, Quarterly, June / 7d), *s3);
+
+		EXPECT_EQ(0u, cache.get_hits());
+		EXPECT_EQ(3u, cache.get_misses());
+	}
+
+	TEST(quasi_coupon_schedule_cache, eviction)
+	{
+		auto cache = quasi_coupon_schedule_cache{ 4, 1 };
+
+		const auto i_m = days_period{ 2023y / January / 1d, 2023y / December / 7d };
+
+		for (auto d = 1u; d <= 10u; ++d)
+			cache.get(i_m, SemiAnnualy, June / day{ d });
+
+		EXPECT_EQ(4u, cache.size());
+		EXPECT_EQ(6u, cache.get_evictions());
+
+		// recently used entries get a second chance
+		const auto s = cache.get(i_m, SemiAnnualy, June / 10d);
+		EXPECT_EQ(1u, cache.get_hits());
+
+		cache.get(i_m, SemiAnnualy, June / 11d);
+		EXPECT_EQ(s, cache.get(i_m, SemiAnnualy, June / 10d));
+		EXPECT_EQ(2u, cache.get_hits());
+	}
+
+	TEST(quasi_coupon_schedule_cache, exception)
+	{
+		auto cache = quasi_coupon_schedule_cache{ 4 };
+
+		const auto i_m = days_period{ 2023y / January / 1d, 2023y / December / 7d };
+
+		EXPECT_THROW(cache.get(i_m, duration_variant{ months{ 0 } }, June / 7d), out_of_range);
+		EXPECT_EQ(0u, cache.size());
+
+		EXPECT_THROW(quasi_coupon_schedule_cache{ 0 }, out_of_range);
+	}
+
+	TEST(quasi_coupon_schedule_cache, concurrency)
+	{
+		auto cache = quasi_coupon_schedule_cache{ 256, 4 }; // big enough to never evict here
+
+		const auto i_m = days_period{ 2023y / January / 1d, 2033y / December / 7d };
+
+		auto expected = vector<schedule>{};
+		for (auto d = 1u; d <= 28u; ++d)
+			expected.push_back(make_quasi_coupon_schedule(i_m, SemiAnnualy, June / day{ d }));
+
+		auto threads = vector<jthread>{};
+		for (auto t = 0; t < 8; ++t)
+			threads.emplace_back([&cache, &i_m, &expected]() {
+				for (auto i = 0u; i < 1000u; ++i)
+				{
+					const auto s = cache.get(i_m, SemiAnnualy, June / day{ 1u + i % 28u });
+					EXPECT_EQ(expected[i % 28u], *s);
+				}
+			});
+		threads.clear();
+
+		EXPECT_EQ(8000u, cache.get_hits() + cache.get_misses());
+		EXPECT_LE(cache.get_misses(), 8u * 28u); // at worst every thread builds every schedule once
+		EXPECT_EQ(28u, cache.size());
+	}
+
+}
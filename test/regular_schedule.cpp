@@ -0,0 +1,146 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <regular_schedule.h>
+#include <quasi_coupon_schedule.h>
+
+#include <schedule.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+#include <iterator>
+#include <stdexcept>
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	TEST(regular_schedule, constructor)
+	{
+		EXPECT_THROW((regular_schedule{ 2023y / June / 7d, SemiAnnualy, 0u }), out_of_range);
+		EXPECT_THROW((regular_schedule{ 2023y / June / 7d, duration_variant{ -months{ 6 } }, 2u }), out_of_range);
+		EXPECT_THROW((regular_schedule{ 2023y / June / 7d, duration_variant{ months{ 0 } }, 2u }), out_of_range);
+	}
+
+	TEST(regular_schedule, operator_square_brackets)
+	{
+		const auto s = regular_schedule{ 2022y / December / 7d, SemiAnnualy, 3u };
+
+		EXPECT_EQ(3u, s.size());
+		EXPECT_EQ(2022y / December / 7d, s[0]);
+		EXPECT_EQ(2023y / June / 7d, s[1]);
+		EXPECT_EQ(2023y / December / 7d, s[2]);
+		EXPECT_EQ(days_period(2022y / December / 7d, 2023y / December / 7d), s.get_from_until());
+	}
+
+	TEST(regular_schedule, make_regular_schedule)
+	{
+		// same as the materialised schedules, for all anchors and frequencies
+		const auto check = [](const days_period& i_m, const duration_variant& f, const quasi_coupon_anchor& a)
+		{
+			const auto expected = make_quasi_coupon_schedule(i_m, f, a);
+			const auto s = make_regular_schedule(i_m, f, a);
+
+			EXPECT_EQ(expected.get_dates().size(), s.size());
+			EXPECT_EQ(expected, s.to_schedule());
+		};
+
+		check(days_period{ 2023y / January / 1d, 2023y / December / 7d }, SemiAnnualy, June / 7d);
+		check(days_period{ 2023y / September / 20d, 2023y / December / 20d }, Quarterly, June / 20d);
+		check(days_period{ 2023y / June / 20d, 2023y / December / 20d }, Quarterly, September / 20d);
+		check(days_period{ 2023y / January / 1d, 2023y / December / 7d }, duration_variant{ -months{ 6 } }, June / 7d);
+		check(days_period{ 2023y / January / 1d, 2023y / December / 7d }, duration_variant{ -months{ 6 } }, December / 7d);
+		check(days_period{ 2022y / December / 7d, 2023y / December / 7d }, duration_variant{ -months{ 6 } }, June / 7d);
+		check(days_period{ 2000y / January / 3d, 2040y / March / 15d }, Quarterly, 1900y / March / 15d);
+		check(days_period{ 2000y / January / 3d, 2040y / March / 15d }, Monthly, 2100y / March / 31d);
+		check(days_period{ 2023y / January / 2d, 2024y / January / 1d }, Weekly, 2023y / January / 2d);
+	}
+
+	TEST(regular_schedule, make_regular_schedule_experimental)
+	{
+		const auto i_m = days_period{ 2023y / January / 2d, 2024y / January / 1d };
+
+		for (const auto& f : { Weekly, duration_variant{ -weeks{ 2 } }, duration_variant{ days{ 10 } }, duration_variant{ -months{ 1 } } })
+			EXPECT_EQ(
+				experimental::make_quasi_coupon_schedule(i_m, f, 2023y / January / 20d),
+				experimental::make_regular_schedule(i_m, f, 2023y / January / 20d).to_schedule()
+			);
+
+		EXPECT_THROW(experimental::make_regular_schedule(i_m, duration_variant{ days{ 0 } }, 2023y / January / 20d), out_of_range);
+	}
+
+	TEST(regular_schedule, next_on_or_after)
+	{
+		const auto s = regular_schedule{ 2022y / December / 7d, SemiAnnualy, 3u };
+
+		EXPECT_EQ(2022y / December / 7d, s.next_on_or_after(1990y / January / 1d));
+		EXPECT_EQ(2022y / December / 7d, s.next_on_or_after(2022y / December / 7d));
+		EXPECT_EQ(2023y / June / 7d, s.next_on_or_after(2022y / December / 8d));
+		EXPECT_EQ(2023y / June / 7d, s.next_on_or_after(2023y / June / 7d));
+		EXPECT_EQ(2023y / December / 7d, s.next_on_or_after(2023y / June / 8d));
+		EXPECT_EQ(nullopt, s.next_on_or_after(2023y / December / 8d));
+		EXPECT_EQ(nullopt, s.next_on_or_after(2050y / December / 7d));
+	}
+
+	TEST(regular_schedule, previous_before)
+	{
+		const auto s = regular_schedule{ 2022y / December / 7d, SemiAnnualy, 3u };
+
+		EXPECT_EQ(nullopt, s.previous_before(1990y / January / 1d));
+		EXPECT_EQ(nullopt, s.previous_before(2022y / December / 7d));
+		EXPECT_EQ(2022y / December / 7d, s.previous_before(2022y / December / 8d));
+		EXPECT_EQ(2022y / December / 7d, s.previous_before(2023y / June / 7d));
+		EXPECT_EQ(2023y / June / 7d, s.previous_before(2023y / December / 7d));
+		EXPECT_EQ(2023y / December / 7d, s.previous_before(2023y / December / 8d));
+		EXPECT_EQ(2023y / December / 7d, s.previous_before(2050y / December / 7d));
+	}
+
+	TEST(regular_schedule, lookups_match_schedule)
+	{
+		// a 30 year monthly schedule checked against the set for every day
+		const auto i_m = days_period{ 2000y / January / 3d, 2030y / January / 3d };
+		const auto s = make_regular_schedule(i_m, Monthly, 2000y / January / 31d);
+		const auto qcs = make_quasi_coupon_schedule(i_m, Monthly, 2000y / January / 31d);
+		const auto& ds = qcs.get_dates();
+
+		for (auto d = sys_days{ 1999y / December / 1d }; d < sys_days{ 2030y / March / 1d }; d += days{ 1 })
+		{
+			const auto ymd = year_month_day{ d };
+
+			const auto i = ds.lower_bound(ymd);
+			EXPECT_EQ(i == ds.cend() ? optional<year_month_day>{} : *i, s.next_on_or_after(ymd));
+
+			EXPECT_EQ(i == ds.cbegin() ? optional<year_month_day>{} : *prev(i), s.previous_before(ymd));
+
+			EXPECT_EQ(ds.contains(ymd), s.contains(ymd));
+		}
+	}
+
+}
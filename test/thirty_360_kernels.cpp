@@ -0,0 +1,153 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <thirty_360_kernels.h>
+#include <day_counts.h>
+
+#include <period.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+
+using namespace gregorian;
+using namespace std;
+using namespace std::chrono;
+
+
+namespace coupon_schedule
+{
+
+	// straight from the 2006 ISDA definitions (4.16 (f), (g) and (h)), with nothing shared with the library code
+	inline auto _reference_thirty_360(const year_month_day& start, const year_month_day& end, const int rule, const year_month_day& termination) -> double
+	{
+		const auto y1 = static_cast<int>(start.year());
+		const auto m1 = static_cast<int>(static_cast<unsigned>(start.month()));
+		auto d1 = static_cast<int>(static_cast<unsigned>(start.day()));
+		const auto y2 = static_cast<int>(end.year());
+		const auto m2 = static_cast<int>(static_cast<unsigned>(end.month()));
+		auto d2 = static_cast<int>(static_cast<unsigned>(end.day()));
+
+		const auto last = [](const year_month_day& d) { return d == year_month_day{ d.year() / d.month() / std::chrono::last }; };
+
+		switch (rule)
+		{
+		case 0: // 30/360
+			if (d1 == 31)
+				d1 = 30;
+			if (d2 == 31 && d1 > 29)
+				d2 = 30;
+			break;
+		case 1: // 30E/360
+			if (d1 == 31)
+				d1 = 30;
+			if (d2 == 31)
+				d2 = 30;
+			break;
+		default: // 30E/360 (ISDA)
+			if (last(start))
+				d1 = 30;
+			if (last(end) && !(end == termination && m2 == 2))
+				d2 = 30;
+			break;
+		}
+
+		return (360.0 * (y2 - y1) + 30.0 * (m2 - m1) + (d2 - d1)) / 360.0;
+	}
+
+
+	inline auto _make_dates() -> vector<year_month_day>
+	{
+		// month ends, the days around them and some ordinary days
+		auto result = vector<year_month_day>{};
+		for (auto ym = 2019y / January; ym <= 2025y / December; ym += months{ 1 })
+			for (const auto d : { 1u, 15u, 28u, 29u, 30u, 31u })
+			{
+				const auto ymd = ym / day{ d };
+				if (ymd.ok())
+					result.push_back(ymd);
+			}
+
+		return result;
+	}
+
+
+	TEST(thirty_360_kernels, reference)
+	{
+		const auto dates = _make_dates();
+		const auto termination = 2024y / February / 29d;
+
+		auto starts = vector<year_month_day>{};
+		auto ends = vector<year_month_day>{};
+		for (auto i = 0u; i < dates.size(); i += 3u)
+			for (auto j = i; j < dates.size(); j += 2u)
+			{
+				starts.push_back(dates[i]);
+				ends.push_back(dates[j]);
+			}
+
+		const auto isda = thirty_e_360_isda{ termination };
+
+		auto r0 = vector<double>(starts.size());
+		auto r1 = vector<double>(starts.size());
+		auto r2 = vector<double>(starts.size());
+		Thirty360.fractions(starts, ends, r0);
+		ThirtyE360.fractions(starts, ends, r1);
+		isda.fractions(starts, ends, r2);
+
+		for (auto i = 0u; i < starts.size(); ++i)
+		{
+			EXPECT_EQ(_reference_thirty_360(starts[i], ends[i], 0, termination), Thirty360.fraction(starts[i], ends[i]));
+			EXPECT_EQ(_reference_thirty_360(starts[i], ends[i], 0, termination), r0[i]);
+
+			EXPECT_EQ(_reference_thirty_360(starts[i], ends[i], 1, termination), ThirtyE360.fraction(starts[i], ends[i]));
+			EXPECT_EQ(_reference_thirty_360(starts[i], ends[i], 1, termination), r1[i]);
+
+			EXPECT_EQ(_reference_thirty_360(starts[i], ends[i], 2, termination), isda.fraction(starts[i], ends[i]));
+			EXPECT_EQ(_reference_thirty_360(starts[i], ends[i], 2, termination), r2[i]);
+		}
+	}
+
+	TEST(thirty_360_kernels, thirty_e_360_isda_fractions)
+	{
+		// the end of February is only kept on the termination date
+		const auto starts = vector<year_month_day>{ 2023y / August / 31d, 2023y / August / 31d, 2023y / August / 31d };
+		const auto ends = vector<year_month_day>{ 2024y / February / 29d, 2024y / February / 29d, 2024y / March / 31d };
+		const auto terminations = vector<year_month_day>{ 2024y / February / 29d, 2030y / February / 28d, 2024y / March / 31d };
+
+		auto result = vector<double>(starts.size());
+		thirty_e_360_isda_fractions(starts, ends, terminations, result);
+
+		EXPECT_DOUBLE_EQ(179.0 / 360.0, result[0]);
+		EXPECT_DOUBLE_EQ(180.0 / 360.0, result[1]);
+		EXPECT_DOUBLE_EQ(210.0 / 360.0, result[2]);
+
+		for (auto i = 0u; i < starts.size(); ++i)
+			EXPECT_EQ(thirty_e_360_isda{ terminations[i] }.fraction(days_period{ starts[i], ends[i] }), result[i]);
+
+		EXPECT_THROW(thirty_e_360_isda_fractions(starts, ends, span{ terminations }.first(2), result), out_of_range);
+	}
+
+}